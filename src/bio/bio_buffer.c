@@ -7,11 +7,17 @@
 #include <spdk/env.h>
 #include <spdk/blob.h>
 #include <spdk/thread.h>
+#include <gurt/atomic.h>
 #include "bio_internal.h"
 
+/* DMA buffer (in pages) allocated by all xstreams of the engine */
+static ATOMIC uint64_t dma_glb_pgs;
+
 static void
 dma_free_chunk(struct bio_dma_chunk *chunk)
 {
+	uint64_t pgs = chunk->bdc_huge_pgs ? chunk->bdc_huge_pgs : bio_chk_sz;
+
 	D_ASSERT(chunk->bdc_ptr != NULL);
 	D_ASSERT(chunk->bdc_pg_idx == 0);
 	D_ASSERT(chunk->bdc_ref == 0);
@@ -22,6 +28,7 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 	else
 		free(chunk->bdc_ptr);
 
+	atomic_fetch_sub(&dma_glb_pgs, pgs);
 	D_FREE(chunk);
 }
 
@@ -54,10 +61,85 @@ dma_alloc_chunk(unsigned int cnt)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&chunk->bdc_link);
+	if (cnt > bio_chk_sz)
+		chunk->bdc_huge_pgs = cnt;
+	atomic_fetch_add(&dma_glb_pgs, (uint64_t)cnt);
+
+	return chunk;
+}
+
+/* Return size class of huge chunk, or -1 when it's too large to be cached */
+static inline int
+dma_huge_class(unsigned int pg_cnt)
+{
+	unsigned int cls = (pg_cnt + bio_chk_sz - 1) / bio_chk_sz;
+
+	D_ASSERT(cls > 1);
+	cls -= 2;
+
+	return cls < BIO_HUGE_CLASS_MAX ? cls : -1;
+}
+
+/*
+ * Huge chunk is rounded up to multiple of chunk size, so that it can be cached
+ * by size class and reused by following huge IOVs of similar size.
+ */
+static struct bio_dma_chunk *
+dma_huge_get(struct bio_dma_buffer *bdb, unsigned int pg_cnt)
+{
+	struct bio_dma_chunk	*chunk;
+	int			 cls = dma_huge_class(pg_cnt);
+
+	if (cls < 0)
+		return dma_alloc_chunk(pg_cnt);
+
+	if (d_list_empty(&bdb->bdb_huge_list[cls]))
+		return dma_alloc_chunk((cls + 2) * bio_chk_sz);
+
+	chunk = d_list_entry(bdb->bdb_huge_list[cls].next, struct bio_dma_chunk,
+			     bdc_link);
+	d_list_del_init(&chunk->bdc_link);
+
+	D_ASSERT(bdb->bdb_huge_pgs >= chunk->bdc_huge_pgs);
+	bdb->bdb_huge_pgs -= chunk->bdc_huge_pgs;
+	d_tm_inc_counter(bdb->bdb_huge_hits, 1);
 
 	return chunk;
 }
 
+static void
+dma_huge_put(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk)
+{
+	int	cls = dma_huge_class(chunk->bdc_huge_pgs);
+
+	D_ASSERT(d_list_empty(&chunk->bdc_link));
+	if (cls < 0 ||
+	    bdb->bdb_huge_pgs + chunk->bdc_huge_pgs > BIO_HUGE_CACHE_MAX * bio_chk_sz) {
+		dma_free_chunk(chunk);
+		return;
+	}
+
+	d_list_add(&chunk->bdc_link, &bdb->bdb_huge_list[cls]);
+	bdb->bdb_huge_pgs += chunk->bdc_huge_pgs;
+}
+
+static void
+dma_huge_drain(struct bio_dma_buffer *bdb)
+{
+	struct bio_dma_chunk	*chunk, *tmp;
+	int			 i;
+
+	for (i = 0; i < BIO_HUGE_CLASS_MAX; i++) {
+		d_list_for_each_entry_safe(chunk, tmp, &bdb->bdb_huge_list[i], bdc_link) {
+			d_list_del_init(&chunk->bdc_link);
+			D_ASSERT(bdb->bdb_huge_pgs >= chunk->bdc_huge_pgs);
+			bdb->bdb_huge_pgs -= chunk->bdc_huge_pgs;
+			dma_free_chunk(chunk);
+		}
+	}
+	D_ASSERT(bdb->bdb_huge_pgs == 0);
+}
+
 static void
 dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 {
@@ -74,6 +156,7 @@ dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 		buf->bdb_tot_cnt--;
 		cnt--;
 	}
+	d_tm_set_gauge(buf->bdb_tot_chks, buf->bdb_tot_cnt);
 }
 
 int
@@ -94,10 +177,87 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 		d_list_add_tail(&chunk->bdc_link, &buf->bdb_idle_list);
 		buf->bdb_tot_cnt++;
 	}
+	d_tm_set_gauge(buf->bdb_tot_chks, buf->bdb_tot_cnt);
 
 	return rc;
 }
 
+/*
+ * Borrow one chunk beyond the per-xstream upper bound when the whole engine
+ * is far from the hugepage budget. The last quarter of the budget is left for
+ * sibling xstreams growing to their own upper bound, and the borrowed chunks
+ * are repaid as soon as they become idle.
+ */
+static bool
+dma_buffer_borrow(struct bio_dma_buffer *buf)
+{
+	struct bio_dma_chunk	*chunk;
+	uint64_t		 glb_pgs;
+
+	if (!bio_dma_borrow || bio_dma_glb_max == 0)
+		return false;
+
+	glb_pgs = atomic_load_relaxed(&dma_glb_pgs);
+	if (glb_pgs + bio_chk_sz > bio_dma_glb_max / 4 * 3)
+		return false;
+
+	chunk = dma_alloc_chunk(bio_chk_sz);
+	if (chunk == NULL)
+		return false;
+
+	d_list_add_tail(&chunk->bdc_link, &buf->bdb_idle_list);
+	buf->bdb_tot_cnt++;
+	buf->bdb_borrowed++;
+
+	d_tm_set_gauge(buf->bdb_tot_chks, buf->bdb_tot_cnt);
+	d_tm_inc_counter(buf->bdb_borrows, 1);
+
+	return true;
+}
+
+static void
+dma_buffer_repay(struct bio_dma_buffer *buf)
+{
+	unsigned int	tot_cnt = buf->bdb_tot_cnt;
+
+	dma_buffer_shrink(buf, buf->bdb_borrowed);
+	D_ASSERT(tot_cnt - buf->bdb_tot_cnt <= buf->bdb_borrowed);
+	buf->bdb_borrowed -= tot_cnt - buf->bdb_tot_cnt;
+}
+
+static void
+dma_metrics_init(struct bio_dma_buffer *buf, int tgt_id)
+{
+	int	rc;
+
+	/* Not a VOS xstream */
+	if (tgt_id < 0)
+		return;
+
+	rc = d_tm_add_metric(&buf->bdb_tot_chks, D_TM_GAUGE, "total chunks of DMA buffer",
+			     "chunks", "dmabuff/total_chunks/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create total chunks telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&buf->bdb_waits, D_TM_COUNTER,
+			     "IOD waits for insufficient DMA buffer", "waits",
+			     "dmabuff/waits/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create waits telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&buf->bdb_borrows, D_TM_COUNTER,
+			     "chunks borrowed beyond per-xstream upper bound", "chunks",
+			     "dmabuff/borrows/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create borrows telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&buf->bdb_huge_hits, D_TM_COUNTER,
+			     "huge chunks reused from cache", "chunks",
+			     "dmabuff/huge_hits/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create huge hits telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
 void
 dma_buffer_destroy(struct bio_dma_buffer *buf)
 {
@@ -105,7 +265,9 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 	D_ASSERT(buf->bdb_active_iods == 0);
 
 	bulk_cache_destroy(buf);
+	dma_huge_drain(buf);
 	dma_buffer_shrink(buf, buf->bdb_tot_cnt);
+	buf->bdb_borrowed = 0;
 
 	D_ASSERT(buf->bdb_tot_cnt == 0);
 	ABT_mutex_free(&buf->bdb_mutex);
@@ -115,10 +277,10 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 }
 
 struct bio_dma_buffer *
-dma_buffer_create(unsigned int init_cnt)
+dma_buffer_create(unsigned int init_cnt, int tgt_id)
 {
 	struct bio_dma_buffer *buf;
-	int rc;
+	int i, rc;
 
 	D_ALLOC_PTR(buf);
 	if (buf == NULL)
@@ -126,8 +288,11 @@ dma_buffer_create(unsigned int init_cnt)
 
 	D_INIT_LIST_HEAD(&buf->bdb_idle_list);
 	D_INIT_LIST_HEAD(&buf->bdb_used_list);
+	for (i = 0; i < BIO_HUGE_CLASS_MAX; i++)
+		D_INIT_LIST_HEAD(&buf->bdb_huge_list[i]);
 	buf->bdb_tot_cnt = 0;
 	buf->bdb_active_iods = 0;
+	dma_metrics_init(buf, tgt_id);
 
 	rc = ABT_mutex_create(&buf->bdb_mutex);
 	if (rc != ABT_SUCCESS) {
@@ -273,7 +438,7 @@ iod_release_buffer(struct bio_desc *biod)
 			chunk->bdc_type);
 
 		if (dma_chunk_is_huge(chunk)) {
-			dma_free_chunk(chunk);
+			dma_huge_put(bdb, chunk);
 		} else if (chunk->bdc_ref == 0) {
 			chunk->bdc_pg_idx = 0;
 			D_ASSERT(bdb->bdb_used_cnt[chunk->bdc_type] > 0);
@@ -285,6 +450,9 @@ iod_release_buffer(struct bio_desc *biod)
 		rsrvd_dma->brd_dma_chks[i] = NULL;
 	}
 
+	if (bdb->bdb_borrowed > 0)
+		dma_buffer_repay(bdb);
+
 	D_FREE(rsrvd_dma->brd_dma_chks);
 	rsrvd_dma->brd_dma_chks = NULL;
 	rsrvd_dma->brd_chk_max = rsrvd_dma->brd_chk_cnt = 0;
@@ -497,7 +665,8 @@ chunk_get_idle(struct bio_dma_buffer *bdb, struct bio_dma_chunk **chk_ptr)
 
 		/* Try to reclaim an unused chunk from bulk groups */
 		rc = bulk_reclaim_chunk(bdb, NULL);
-		if (rc)
+		/* Try to borrow from the quota unused by sibling xstreams */
+		if (rc && !dma_buffer_borrow(bdb))
 			return rc;
 	}
 done:
@@ -724,20 +893,18 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	/*
 	 * For huge IOV, we'll bypass our per-xstream DMA buffer cache and
 	 * allocate chunk from the SPDK reserved huge pages directly, this
-	 * kind of huge chunk will be freed immediately on I/O completion.
-	 *
-	 * We assume the contiguous huge IOV is quite rare, so there won't
-	 * be high contention over the SPDK huge page cache.
+	 * kind of huge chunk will be put in a small per-xstream huge chunk
+	 * cache or freed on I/O completion.
 	 */
 	if (pg_cnt > bio_chk_sz) {
-		chk = dma_alloc_chunk(pg_cnt);
+		chk = dma_huge_get(bdb, pg_cnt);
 		if (chk == NULL)
 			return -DER_NOMEM;
 
 		chk->bdc_type = biod->bd_chk_type;
 		rc = iod_add_chunk(biod, chk);
 		if (rc) {
-			dma_free_chunk(chk);
+			dma_huge_put(bdb, chk);
 			return rc;
 		}
 		bio_iov_set_raw_buf(biov, chk->bdc_ptr + pg_off);
@@ -947,6 +1114,143 @@ scm_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 		   payload, rg->brr_end - rg->brr_off);
 }
 
+/*
+ * Prefetch the head of next SCM region while copying the current one, the
+ * hardware prefetcher takes over once the sequential copy gets started.
+ */
+static void
+scm_prefetch(struct bio_desc *biod, struct bio_rsrvd_region *rg)
+{
+	struct umem_instance	*umem = biod->bd_ctxt->bic_umem;
+	char			*addr;
+	uint64_t		 len, off;
+
+	D_ASSERT(rg->brr_media == DAOS_MEDIA_SCM);
+	addr = umem_off2ptr(umem, rg->brr_off);
+	len = min(rg->brr_end - rg->brr_off, BIO_SCM_PREFETCH_SZ);
+
+	for (off = 0; off < len; off += BIO_CACHE_LINE_SZ)
+		__builtin_prefetch(addr + off, 0, 0);
+}
+
+static bool
+nvme_rw_allowed(struct bio_desc *biod)
+{
+	/* Bypass NVMe I/O, used by daos_perf for performance evaluation */
+	if (daos_io_bypass & IOBP_NVME)
+		return false;
+
+	if (!is_blob_valid(biod->bd_ctxt)) {
+		D_ERROR("Blobstore is invalid. blob:%p, closing:%d\n",
+			biod->bd_ctxt->bic_blob, biod->bd_ctxt->bic_closing);
+		biod->bd_result = -DER_NO_HDL;
+		return false;
+	}
+
+	return true;
+}
+
+static inline uint64_t
+nvme_rg_pg_start(struct bio_rsrvd_region *rg)
+{
+	return rg->brr_off >> BIO_DMA_PAGE_SHIFT;
+}
+
+static inline uint64_t
+nvme_rg_pg_end(struct bio_rsrvd_region *rg)
+{
+	return (rg->brr_end + BIO_DMA_PAGE_SZ - 1) >> BIO_DMA_PAGE_SHIFT;
+}
+
+/*
+ * Count how many NVMe regions starting from @rg_idx are contiguous on the
+ * device, so they can be submitted by a single vectored blob I/O.
+ */
+static unsigned int
+nvme_rg_merge_cnt(struct bio_rsrvd_dma *rsrvd_dma, unsigned int rg_idx)
+{
+	struct bio_rsrvd_region	*rg = &rsrvd_dma->brd_regions[rg_idx];
+	struct bio_rsrvd_region	*next;
+	uint64_t		 pg_cnt;
+	unsigned int		 i;
+
+	D_ASSERT(rg->brr_media == DAOS_MEDIA_NVME);
+	pg_cnt = nvme_rg_pg_end(rg) - nvme_rg_pg_start(rg);
+
+	for (i = rg_idx + 1; i < rsrvd_dma->brd_rg_cnt; i++) {
+		if (i - rg_idx >= BIO_MERGE_IOV_MAX)
+			break;
+
+		next = &rsrvd_dma->brd_regions[i];
+		if (next->brr_media != DAOS_MEDIA_NVME ||
+		    nvme_rg_pg_start(next) != nvme_rg_pg_end(rg))
+			break;
+
+		pg_cnt += nvme_rg_pg_end(next) - nvme_rg_pg_start(next);
+		if (pg_cnt > bio_nvme_merge_max)
+			break;
+
+		rg = next;
+	}
+
+	return i - rg_idx;
+}
+
+/* Submit @rg_cnt device contiguous NVMe regions in one vectored blob I/O */
+static void
+nvme_rwv(struct bio_desc *biod, struct bio_rsrvd_region *rgs, unsigned int rg_cnt,
+	 struct iovec *iovs)
+{
+	struct spdk_io_channel	*channel;
+	struct spdk_blob	*blob;
+	struct bio_xs_context	*xs_ctxt;
+	uint64_t		 pg_idx, pg_cnt = 0, rg_pgs;
+	unsigned int		 i;
+
+	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
+	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
+	blob = biod->bd_ctxt->bic_blob;
+	channel = xs_ctxt->bxc_io_channel;
+
+	if (!nvme_rw_allowed(biod))
+		return;
+
+	D_ASSERT(channel != NULL);
+	D_ASSERT(rg_cnt > 1);
+	for (i = 0; i < rg_cnt; i++) {
+		D_ASSERT(rgs[i].brr_chk_off == 0);
+		rg_pgs = nvme_rg_pg_end(&rgs[i]) - nvme_rg_pg_start(&rgs[i]);
+		iovs[i].iov_base = rgs[i].brr_chk->bdc_ptr +
+				   (rgs[i].brr_pg_idx << BIO_DMA_PAGE_SHIFT);
+		iovs[i].iov_len = rg_pgs << BIO_DMA_PAGE_SHIFT;
+		pg_cnt += rg_pgs;
+	}
+	pg_idx = nvme_rg_pg_start(&rgs[0]);
+
+	/* NVMe poll needs be scheduled */
+	if (bio_need_nvme_poll(xs_ctxt))
+		bio_yield();
+
+	biod->bd_inflights++;
+	xs_ctxt->bxc_blob_rw++;
+
+	D_DEBUG(DB_IO, "%s blob:%p iovs:%u, pg_idx:"DF_U64", pg_cnt:"DF_U64"\n",
+		biod->bd_type == BIO_IOD_TYPE_UPDATE ? "Writev" : "Readv",
+		blob, rg_cnt, pg_idx, pg_cnt);
+
+	D_ASSERT(biod->bd_type < BIO_IOD_TYPE_GETBUF);
+	if (biod->bd_type == BIO_IOD_TYPE_UPDATE)
+		spdk_blob_io_writev(blob, channel, iovs, rg_cnt,
+				    page2io_unit(biod->bd_ctxt, pg_idx),
+				    page2io_unit(biod->bd_ctxt, pg_cnt),
+				    rw_completion, biod);
+	else
+		spdk_blob_io_readv(blob, channel, iovs, rg_cnt,
+				   page2io_unit(biod->bd_ctxt, pg_idx),
+				   page2io_unit(biod->bd_ctxt, pg_cnt),
+				   rw_completion, biod);
+}
+
 static void
 nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 {
@@ -961,17 +1265,9 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	blob = biod->bd_ctxt->bic_blob;
 	channel = xs_ctxt->bxc_io_channel;
 
-	/* Bypass NVMe I/O, used by daos_perf for performance evaluation */
-	if (daos_io_bypass & IOBP_NVME)
+	if (!nvme_rw_allowed(biod))
 		return;
 
-	if (!is_blob_valid(biod->bd_ctxt)) {
-		D_ERROR("Blobstore is invalid. blob:%p, closing:%d\n",
-			blob, biod->bd_ctxt->bic_closing);
-		biod->bd_result = -DER_NO_HDL;
-		return;
-	}
-
 	D_ASSERT(channel != NULL);
 	D_ASSERT(rg->brr_chk_off == 0);
 	payload = rg->brr_chk->bdc_ptr + (rg->brr_pg_idx << BIO_DMA_PAGE_SHIFT);
@@ -1016,9 +1312,10 @@ static void
 dma_rw(struct bio_desc *biod)
 {
 	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
-	struct bio_rsrvd_region	*rg;
+	struct bio_rsrvd_region	*rg, *next;
 	struct bio_xs_context	*xs_ctxt;
-	int			 i;
+	struct iovec		*iovs = NULL;
+	unsigned int		 i, merged, scm_cnt = 0;
 
 	D_ASSERT(biod->bd_ctxt->bic_xs_ctxt);
 	xs_ctxt = biod->bd_ctxt->bic_xs_ctxt;
@@ -1031,18 +1328,54 @@ dma_rw(struct bio_desc *biod)
 	D_ASSERT(biod->bd_type < BIO_IOD_TYPE_GETBUF);
 	D_DEBUG(DB_IO, "DMA start, type:%d\n", biod->bd_type);
 
-	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
+	/*
+	 * The iovec array must stay valid till the vectored I/Os are completed,
+	 * merging is simply skipped when it can't be allocated.
+	 */
+	if (bio_nvme_merge_max != 0 && rsrvd_dma->brd_rg_cnt > 1)
+		D_ALLOC_ARRAY(iovs, rsrvd_dma->brd_rg_cnt);
+
+	/*
+	 * Submit all NVMe I/Os before copying SCM regions, so that the SCM
+	 * copies are overlapped with the inflight NVMe I/Os.
+	 */
+	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i += merged) {
 		rg = &rsrvd_dma->brd_regions[i];
+		merged = 1;
 
 		D_ASSERT(rg->brr_chk != NULL);
 		D_ASSERT(rg->brr_end > rg->brr_off);
 
-		if (rg->brr_media == DAOS_MEDIA_SCM)
-			scm_rw(biod, rg);
+		if (rg->brr_media == DAOS_MEDIA_SCM) {
+			scm_cnt++;
+			continue;
+		}
+
+		if (iovs != NULL)
+			merged = nvme_rg_merge_cnt(rsrvd_dma, i);
+
+		if (merged > 1)
+			nvme_rwv(biod, rg, merged, &iovs[i]);
 		else
 			nvme_rw(biod, rg);
 	}
 
+	for (i = 0, rg = NULL; scm_cnt > 0; i++) {
+		next = &rsrvd_dma->brd_regions[i];
+		if (next->brr_media != DAOS_MEDIA_SCM)
+			continue;
+
+		if (bio_scm_prefetch && biod->bd_type == BIO_IOD_TYPE_FETCH)
+			scm_prefetch(biod, next);
+		if (rg != NULL)
+			scm_rw(biod, rg);
+
+		rg = next;
+		scm_cnt--;
+	}
+	if (rg != NULL)
+		scm_rw(biod, rg);
+
 	if (xs_ctxt->bxc_self_polling) {
 		D_DEBUG(DB_IO, "Self poll completion\n");
 		xs_poll_completion(xs_ctxt, &biod->bd_inflights, 0);
@@ -1053,6 +1386,7 @@ dma_rw(struct bio_desc *biod)
 	}
 
 	biod->bd_ctxt->bic_inflight_dmas--;
+	D_FREE(iovs);
 	D_DEBUG(DB_IO, "DMA done, type:%d\n", biod->bd_type);
 }
 
@@ -1127,6 +1461,7 @@ retry:
 
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n",
 			biod, retry_cnt++);
+		d_tm_inc_counter(bdb->bdb_waits, 1);
 
 		ABT_mutex_lock(bdb->bdb_mutex);
 		ABT_cond_wait(bdb->bdb_wait_iods, bdb->bdb_mutex);
@@ -18,6 +18,15 @@
 #define BIO_DMA_PAGE_SHIFT	12	/* 4K */
 #define BIO_DMA_PAGE_SZ		(1UL << BIO_DMA_PAGE_SHIFT)
 #define BIO_XS_CNT_MAX		48	/* Max VOS xstreams per blobstore */
+/* Size classes of cached huge DMA chunks, from 2 to 9 DMA chunk size */
+#define BIO_HUGE_CLASS_MAX	8
+/* Max size (in DMA chunk size) of cached idle huge DMA chunks per xstream */
+#define BIO_HUGE_CACHE_MAX	4
+/* Max regions merged into one vectored NVMe I/O */
+#define BIO_MERGE_IOV_MAX	32
+/* Bytes prefetched from the head of next SCM region on fetch */
+#define BIO_SCM_PREFETCH_SZ	(4UL << 10)
+#define BIO_CACHE_LINE_SZ	64
 /*
  * Period to query raw device health stats, auto detect faulty and transition
  * device state. 60 seconds by default. Once FAULTY state has occurred, reduce
@@ -80,6 +89,8 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_ref;
 	/* Chunk type */
 	unsigned int	 bdc_type;
+	/* Size in pages (4k page), only set for huge chunk */
+	unsigned int	 bdc_huge_pgs;
 	/* == Bulk handle caching related fields == */
 	struct bio_bulk_group	*bdc_bulk_grp;
 	struct bio_bulk_hdl	*bdc_bulks;
@@ -112,6 +123,16 @@ struct bio_dma_buffer {
 	ABT_cond		 bdb_wait_iods;
 	ABT_mutex		 bdb_mutex;
 	struct bio_bulk_cache	 bdb_bulk_cache;
+	/* Idle huge chunks, categorized by size class */
+	d_list_t		 bdb_huge_list[BIO_HUGE_CLASS_MAX];
+	unsigned int		 bdb_huge_pgs;
+	/* Chunks borrowed beyond per-xstream upper bound */
+	unsigned int		 bdb_borrowed;
+	/* Telemetry */
+	struct d_tm_node_t	*bdb_tot_chks;
+	struct d_tm_node_t	*bdb_waits;
+	struct d_tm_node_t	*bdb_borrows;
+	struct d_tm_node_t	*bdb_huge_hits;
 };
 
 #define BIO_PROTO_NVME_STATS_LIST					\
@@ -489,10 +510,14 @@ struct media_error_msg {
 
 /* bio_xstream.c */
 extern bool		bio_scm_rdma;
+extern bool		bio_scm_prefetch;
 extern bool		bio_spdk_inited;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
 extern unsigned int	bio_numa_node;
+extern uint64_t		bio_dma_glb_max;
+extern bool		bio_dma_borrow;
+extern unsigned int	bio_nvme_merge_max;
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
 void bio_bdev_event_cb(enum spdk_bdev_event_type type, struct spdk_bdev *bdev,
@@ -517,7 +542,7 @@ bool bypass_health_collect(void);
 
 /* bio_buffer.c */
 void dma_buffer_destroy(struct bio_dma_buffer *buf);
-struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt);
+struct bio_dma_buffer *dma_buffer_create(unsigned int init_cnt, int tgt_id);
 void bio_memcpy(struct bio_desc *biod, uint16_t media, void *media_addr,
 		void *addr, ssize_t n);
 int dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg);
@@ -568,9 +593,9 @@ dump_dma_info(struct bio_dma_buffer *bdb)
 	struct bio_bulk_group	*bbg;
 	int			 i, bulk_grps = 0, bulk_chunks = 0;
 
-	D_EMIT("chk_size:%u, tot_chk:%u/%u, active_iods:%u, used:%u,%u,%u\n",
-		bio_chk_sz, bdb->bdb_tot_cnt, bio_chk_cnt_max,
-		bdb->bdb_active_iods, bdb->bdb_used_cnt[BIO_CHK_TYPE_IO],
+	D_EMIT("chk_size:%u, tot_chk:%u/%u, borrowed:%u, active_iods:%u, "
+		"used:%u,%u,%u\n", bio_chk_sz, bdb->bdb_tot_cnt, bio_chk_cnt_max,
+		bdb->bdb_borrowed, bdb->bdb_active_iods, bdb->bdb_used_cnt[BIO_CHK_TYPE_IO],
 		bdb->bdb_used_cnt[BIO_CHK_TYPE_LOCAL],
 		bdb->bdb_used_cnt[BIO_CHK_TYPE_REBUILD]);
 
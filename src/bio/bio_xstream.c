@@ -32,6 +32,7 @@
 #define DAOS_DMA_CHUNK_CNT_INIT	32	/* Per-xstream init chunks */
 #define DAOS_DMA_CHUNK_CNT_MAX	128	/* Per-xstream max chunks */
 #define DAOS_DMA_MIN_UB_BUF_MB	1024	/* 1GB min upper bound DMA buffer */
+#define DAOS_NVME_MERGE_KB	1024	/* 1MB max merged NVMe I/O */
 
 /* Max inflight blob IOs per io channel */
 #define BIO_BS_MAX_CHANNEL_OPS	(4096)
@@ -46,8 +47,16 @@ unsigned int bio_chk_cnt_max;
 unsigned int bio_numa_node;
 /* Per-xstream initial DMA buffer size (in chunk count) */
 static unsigned int bio_chk_cnt_init;
+/* Engine-wide DMA buffer upper bound (in pages), 0 means unlimited */
+uint64_t bio_dma_glb_max;
+/* Borrow DMA buffer quota unused by sibling xstreams */
+bool bio_dma_borrow = true;
+/* Max size (in pages) of merged NVMe I/O, 0 means merging disabled */
+unsigned int bio_nvme_merge_max;
 /* Diret RDMA over SCM */
 bool bio_scm_rdma;
+/* Prefetch SCM regions on fetch */
+bool bio_scm_prefetch;
 /* Whether SPDK inited */
 bool bio_spdk_inited;
 /* SPDK subsystem fini timeout */
@@ -162,7 +171,7 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 {
 	char		*env;
 	int		 rc, fd;
-	unsigned int	 size_mb = DAOS_DMA_CHUNK_MB;
+	unsigned int	 size_mb = DAOS_DMA_CHUNK_MB, merge_kb;
 
 	if (tgt_nr <= 0) {
 		D_ERROR("tgt_nr: %u should be > 0\n", tgt_nr);
@@ -195,13 +204,22 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	bio_chk_cnt_init = DAOS_DMA_CHUNK_CNT_INIT;
 	bio_chk_cnt_max = DAOS_DMA_CHUNK_CNT_MAX;
 	bio_chk_sz = ((uint64_t)size_mb << 20) >> BIO_DMA_PAGE_SHIFT;
+	bio_dma_glb_max = 0;
 
 	d_getenv_bool("DAOS_SCM_RDMA_ENABLED", &bio_scm_rdma);
 	D_INFO("RDMA to SCM is %s\n", bio_scm_rdma ? "enabled" : "disabled");
 
+	d_getenv_bool("DAOS_SCM_PREFETCH", &bio_scm_prefetch);
+	D_INFO("SCM prefetch is %s\n", bio_scm_prefetch ? "enabled" : "disabled");
+
 	d_getenv_int("DAOS_SPDK_SUBSYS_TIMEOUT", &bio_spdk_subsys_timeout);
 	D_INFO("SPDK subsystem fini timeout is %u ms\n", bio_spdk_subsys_timeout);
 
+	merge_kb = DAOS_NVME_MERGE_KB;
+	d_getenv_int("DAOS_NVME_MERGE_KB", &merge_kb);
+	bio_nvme_merge_max = merge_kb >> (BIO_DMA_PAGE_SHIFT - 10);
+	D_INFO("Max merged NVMe I/O size is %u KB\n", merge_kb);
+
 	/* Hugepages disabled */
 	if (mem_size == 0) {
 		D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
@@ -235,6 +253,14 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
 	       bio_chk_cnt_max, size_mb);
 
+	/*
+	 * All xstreams of the engine are bound to the same NUMA node, idle
+	 * xstreams can lend their unused DMA buffer quota to the busy ones.
+	 */
+	bio_dma_glb_max = (uint64_t)bio_chk_cnt_max * tgt_nr * bio_chk_sz;
+	d_getenv_bool("DAOS_DMA_BORROW", &bio_dma_borrow);
+	D_INFO("DMA buffer borrowing is %s\n", bio_dma_borrow ? "enabled" : "disabled");
+
 	rc = smd_init(db);
 	if (rc != 0) {
 		D_ERROR("Initialize SMD store failed. "DF_RC"\n", DP_RC(rc));
@@ -1300,7 +1326,7 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id, bool self_polling)
 
 	/* Skip NVMe context setup if the daos_nvme.conf isn't present */
 	if (!bio_nvme_configured()) {
-		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init);
+		ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id);
 		if (ctxt->bxc_dma_buf == NULL) {
 			D_FREE(ctxt);
 			*pctxt = NULL;
@@ -1376,7 +1402,7 @@ bio_xsctxt_alloc(struct bio_xs_context **pctxt, int tgt_id, bool self_polling)
 	if (rc)
 		goto out;
 
-	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init);
+	ctxt->bxc_dma_buf = dma_buffer_create(bio_chk_cnt_init, tgt_id);
 	if (ctxt->bxc_dma_buf == NULL) {
 		D_ERROR("failed to initialize dma buffer\n");
 		rc = -DER_NOMEM;
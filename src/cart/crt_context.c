@@ -272,6 +272,36 @@ crt_context_provider_create(crt_context_t *crt_ctx, int provider)
 		if (ret)
 			D_WARN("Failed to create failed addr counter: "DF_RC
 			       "\n", DP_RC(ret));
+
+		ret = d_tm_add_metric(&ctx->cc_hg_pool_hit, D_TM_COUNTER,
+				      "Total number of HG handles reused from "
+				      "the pool", "reqs",
+				      "net/%s/hg_pool_hit/ctx_%u",
+				      prov, ctx->cc_idx);
+		if (ret)
+			D_WARN("Failed to create hg pool hit counter: "DF_RC
+			       "\n", DP_RC(ret));
+
+		ret = d_tm_add_metric(&ctx->cc_hg_pool_miss, D_TM_COUNTER,
+				      "Total number of HG handles created on "
+				      "pool miss", "reqs",
+				      "net/%s/hg_pool_miss/ctx_%u",
+				      prov, ctx->cc_idx);
+		if (ret)
+			D_WARN("Failed to create hg pool miss counter: "DF_RC
+			       "\n", DP_RC(ret));
+
+		ret = d_tm_add_metric(&ctx->cc_hg_pool_max, D_TM_GAUGE,
+				      "Max number of HG handles kept in the "
+				      "pool", "handles",
+				      "net/%s/hg_pool_max/ctx_%u",
+				      prov, ctx->cc_idx);
+		if (ret)
+			D_WARN("Failed to create hg pool max gauge: "DF_RC
+			       "\n", DP_RC(ret));
+		else
+			d_tm_set_gauge(ctx->cc_hg_pool_max,
+				       ctx->cc_hg_ctx.chc_hg_pool.chp_max_num);
 	}
 
 	if (crt_is_service() &&
@@ -185,6 +185,9 @@ crt_hg_pool_enable(struct crt_hg_context *hg_ctx, int32_t max_num,
 
 	D_SPIN_LOCK(&hg_pool->chp_lock);
 	hg_pool->chp_max_num = max_num;
+	hg_pool->chp_base_num = max_num;
+	hg_pool->chp_gets = 0;
+	hg_pool->chp_misses = 0;
 	hg_pool->chp_enabled = true;
 	prepost = hg_pool->chp_num < prepost_num;
 	D_SPIN_UNLOCK(&hg_pool->chp_lock);
@@ -289,25 +292,61 @@ crt_hg_pool_fini(struct crt_hg_context *hg_ctx)
 	}
 }
 
+/**
+ * Tune the max number of HG handles in the pool based on the miss ratio since
+ * last tuning. Handles created on miss are kept by crt_hg_pool_put() up to the
+ * new max number, so the pool grows with the number of in-flight requests and
+ * shrinks back (lazily, by not keeping returned handles) once they are idle.
+ * Called with chp_lock held, returns true if the max number changed.
+ */
+static inline bool
+crt_hg_pool_tune(struct crt_hg_pool *hg_pool)
+{
+	int32_t	max_num = hg_pool->chp_max_num;
+
+	if (hg_pool->chp_misses * CRT_HG_POOL_MISS_RATIO > hg_pool->chp_gets)
+		max_num = min(max_num * 2, CRT_HG_POOL_MAX_LIMIT);
+	else if (hg_pool->chp_misses == 0 && hg_pool->chp_num > max_num / 2)
+		max_num = max(max_num / 2, hg_pool->chp_base_num);
+
+	hg_pool->chp_gets = 0;
+	hg_pool->chp_misses = 0;
+
+	if (max_num == hg_pool->chp_max_num)
+		return false;
+
+	D_DEBUG(DB_NET, "hg_pool %p, tune max_num from %d to %d, chp_num %d.\n",
+		hg_pool, hg_pool->chp_max_num, max_num, hg_pool->chp_num);
+	hg_pool->chp_max_num = max_num;
+
+	return true;
+}
+
 static inline struct crt_hg_hdl *
 crt_hg_pool_get(struct crt_hg_context *hg_ctx)
 {
+	struct crt_context	*ctx = container_of(hg_ctx, struct crt_context, cc_hg_ctx);
 	struct crt_hg_pool	*hg_pool = &hg_ctx->chc_hg_pool;
 	struct crt_hg_hdl	*hdl = NULL;
+	int32_t			 max_num = -1;
 
 	D_SPIN_LOCK(&hg_pool->chp_lock);
 	if (!hg_pool->chp_enabled) {
 		D_DEBUG(DB_NET,
 			"hg_pool %p is not enabled cannot get.\n", hg_pool);
-		D_GOTO(unlock, hdl);
+		D_SPIN_UNLOCK(&hg_pool->chp_lock);
+		return NULL;
 	}
+
+	hg_pool->chp_gets++;
 	hdl = d_list_pop_entry(&hg_pool->chp_list,
 			       struct crt_hg_hdl,
 			       chh_link);
 	if (hdl == NULL) {
+		hg_pool->chp_misses++;
 		D_DEBUG(DB_NET,
 			"hg_pool %p is empty, cannot get.\n", hg_pool);
-		D_GOTO(unlock, hdl);
+		D_GOTO(tune, hdl);
 	}
 
 	D_ASSERT(hdl->chh_hdl != HG_HANDLE_NULL);
@@ -316,8 +355,19 @@ crt_hg_pool_get(struct crt_hg_context *hg_ctx)
 	D_DEBUG(DB_NET, "hg_pool %p, remove, chp_num %d.\n",
 		hg_pool, hg_pool->chp_num);
 
-unlock:
+tune:
+	if (hg_pool->chp_gets >= CRT_HG_POOL_TUNE_INTVL &&
+	    crt_hg_pool_tune(hg_pool))
+		max_num = hg_pool->chp_max_num;
 	D_SPIN_UNLOCK(&hg_pool->chp_lock);
+
+	if (hdl != NULL)
+		d_tm_inc_counter(ctx->cc_hg_pool_hit, 1);
+	else
+		d_tm_inc_counter(ctx->cc_hg_pool_miss, 1);
+	if (max_num >= 0)
+		d_tm_set_gauge(ctx->cc_hg_pool_max, max_num);
+
 	return hdl;
 }
 
@@ -26,6 +26,12 @@
 #define CRT_HG_POOL_MAX_NUM	(512)
 /** number of prepost HG handles when enable pool */
 #define CRT_HG_POOL_PREPOST_NUM	(16)
+/** upper limit of HG handle pool size when auto-tuning */
+#define CRT_HG_POOL_MAX_LIMIT	(8192)
+/** number of handle requests between two pool size tunings */
+#define CRT_HG_POOL_TUNE_INTVL	(1024)
+/** enlarge the pool if more than 1/CRT_HG_POOL_MISS_RATIO requests missed */
+#define CRT_HG_POOL_MISS_RATIO	(16)
 
 struct crt_rpc_priv;
 struct crt_common_hdr;
@@ -105,6 +111,11 @@ struct crt_hg_pool {
 	int32_t			chp_num;
 	/* maximum number of HG handles in pool */
 	int32_t			chp_max_num;
+	/* maximum number set by crt_hg_pool_enable(), lower bound for auto-tuning */
+	int32_t			chp_base_num;
+	/* handle requests and misses since last tuning */
+	uint32_t		chp_gets;
+	uint32_t		chp_misses;
 	/* HG handle list */
 	d_list_t		chp_list;
 	bool			chp_enabled;
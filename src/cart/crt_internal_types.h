@@ -193,6 +193,12 @@ struct crt_context {
 	struct d_tm_node_t	*cc_timedout_uri;
 	/** Total number of failed address resolution, of type counter */
 	struct d_tm_node_t	*cc_failed_addr;
+	/** Total number of HG handle requests served by the pool, of type counter */
+	struct d_tm_node_t	*cc_hg_pool_hit;
+	/** Total number of HG handle requests that needed HG_Create, of type counter */
+	struct d_tm_node_t	*cc_hg_pool_miss;
+	/** Current max size of the HG handle pool, of type gauge */
+	struct d_tm_node_t	*cc_hg_pool_max;
 
 	/** Stores self uri for the current context */
 	char			 cc_self_uri[CRT_ADDR_STR_MAX_LEN];
@@ -701,15 +701,20 @@ btr_node_tx_add(struct btr_context *tcx, umem_off_t nd_off)
 /* helper functions */
 
 static struct btr_record *
-btr_node_rec_at(struct btr_context *tcx, umem_off_t nd_off,
-		unsigned int at)
+btr_nd_rec_at(struct btr_context *tcx, struct btr_node *nd, unsigned int at)
 {
-	struct btr_node *nd = btr_off2ptr(tcx, nd_off);
 	char		*addr = (char *)&nd[1];
 
 	return (struct btr_record *)&addr[btr_rec_size(tcx) * at];
 }
 
+static struct btr_record *
+btr_node_rec_at(struct btr_context *tcx, umem_off_t nd_off,
+		unsigned int at)
+{
+	return btr_nd_rec_at(tcx, btr_off2ptr(tcx, nd_off), at);
+}
+
 static umem_off_t
 btr_node_child_at(struct btr_context *tcx, umem_off_t nd_off,
 		  unsigned int at)
@@ -726,6 +731,20 @@ btr_node_child_at(struct btr_context *tcx, umem_off_t nd_off,
 	return rec->rec_off;
 }
 
+/**
+ * Return a read-only node for searching, an intermediate node can be served
+ * from the DRAM node cache of the current xstream.
+ */
+static inline struct btr_node *
+btr_node_read(struct btr_context *tcx, umem_off_t nd_off, int level)
+{
+	if (level < tcx->tc_depth - 1)
+		return umem_node_cache_read(btr_umm(tcx), nd_off,
+					    btr_node_size(tcx));
+
+	return btr_off2ptr(tcx, nd_off);
+}
+
 static inline bool
 btr_node_is_full(struct btr_context *tcx, umem_off_t nd_off)
 {
@@ -1353,23 +1372,16 @@ done:
 }
 
 static int
-btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
-	int at, char *hkey, d_iov_t *key)
+btr_nd_cmp(struct btr_context *tcx, struct btr_node *nd,
+	   int at, char *hkey, d_iov_t *key)
 {
 	struct btr_record *rec;
 	int		   cmp;
 
-	if (UMOFF_IS_NULL(nd_off)) { /* compare the leaf trace */
-		struct btr_trace *trace = &tcx->tc_traces[BTR_TRACE_MAX - 1];
-
-		nd_off = trace->tr_node;
-		at = trace->tr_at;
-	}
-
-	rec = btr_node_rec_at(tcx, nd_off, at);
+	rec = btr_nd_rec_at(tcx, nd, at);
 	if (btr_is_direct_key(tcx)) {
 		/* For direct keys, resolve the offset in the record */
-		if (!btr_node_is_leaf(tcx, nd_off))
+		if (!(nd->tn_flags & BTR_NODE_LEAF))
 			rec = btr_node_rec_at(tcx, rec->rec_node[0], 0);
 
 		cmp = btr_key_cmp(tcx, rec, key);
@@ -1390,6 +1402,59 @@ btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
 	return cmp;
 }
 
+static int
+btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
+	int at, char *hkey, d_iov_t *key)
+{
+	if (UMOFF_IS_NULL(nd_off)) { /* compare the leaf trace */
+		struct btr_trace *trace = &tcx->tc_traces[BTR_TRACE_MAX - 1];
+
+		nd_off = trace->tr_node;
+		at = trace->tr_at;
+	}
+
+	return btr_nd_cmp(tcx, btr_off2ptr(tcx, nd_off), at, hkey, key);
+}
+
+/**
+ * Search \a key in a node of an integer key tree.
+ *
+ * Keys of a node are sorted, so the position of \a key is the number of keys
+ * smaller than it. Counting them is a scan without data dependent branches
+ * which the compiler can vectorize, it is cheaper than a binary search of
+ * callback based comparisons for the tree orders we use.
+ *
+ * The returned position and \a cmp are the same as the binary search could
+ * have ended with: the matched record, the first record larger than \a key,
+ * or the last record if all records are smaller than \a key.
+ */
+static int
+btr_node_search_uint(struct btr_context *tcx, struct btr_node *nd,
+		     uint64_t key, int *cmp)
+{
+	struct btr_record	*rec = btr_nd_rec_at(tcx, nd, 0);
+	uint32_t		 stride = btr_rec_size(tcx) / sizeof(uint64_t);
+	uint64_t		*ukey = &rec->rec_ukey[0];
+	int			 keyn = nd->tn_keyn;
+	int			 at = 0;
+	int			 i;
+
+	D_ASSERT(btr_is_int_key(tcx));
+	D_ASSERT(keyn > 0);
+
+	for (i = 0; i < keyn; i++)
+		at += (ukey[i * stride] < key);
+
+	if (at == keyn) {
+		*cmp = BTR_CMP_LT;
+		return keyn - 1;
+	}
+
+	*cmp = ukey[at * stride] == key ? BTR_CMP_EQ : BTR_CMP_GT;
+	D_DEBUG(DB_TRACE, "searched record at %d, cmp %d\n", at, *cmp);
+	return at;
+}
+
 bool
 btr_probe_valid(dbtree_probe_opc_t opc)
 {
@@ -1449,7 +1514,7 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		if (next_level) { /* search a new level of the tree */
 			next_level = false;
 			start	= 0;
-			nd	= btr_off2ptr(tcx, nd_off);
+			nd	= btr_node_read(tcx, nd_off, level);
 			end	= nd->tn_keyn - 1;
 
 			D_DEBUG(DB_TRACE,
@@ -1464,11 +1529,17 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		} else if (probe_opc == BTR_PROBE_LAST) {
 			at = start = end;
 			cmp = BTR_CMP_LT;
+		} else if (hkey != NULL && btr_is_int_key(tcx)) {
+			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
+			/* scan the whole node at once */
+			at = start = end = btr_node_search_uint(tcx, nd,
+							*(uint64_t *)hkey,
+							&cmp);
 		} else {
 			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
 			/* binary search */
 			at = (start + end) / 2;
-			cmp = btr_cmp(tcx, nd_off, at, hkey, key);
+			cmp = btr_nd_cmp(tcx, nd, at, hkey, key);
 		}
 
 		if (cmp == BTR_CMP_ERR) {
@@ -1487,7 +1558,7 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 			continue;
 		}
 
-		if (btr_node_is_leaf(tcx, nd_off))
+		if (nd->tn_flags & BTR_NODE_LEAF)
 			break;
 
 		/* NB: cmp is BTR_CMP_LT or BTR_CMP_EQ means search the record
@@ -1497,8 +1568,9 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		btr_trace_set(tcx, level, nd_off, at);
 		btr_trace_debug(tcx, &tcx->tc_trace[level], "probe child\n");
 
-		/* Search the next level. */
-		nd_off = btr_node_child_at(tcx, nd_off, at);
+		/* Search the next level, nd can be a cached copy */
+		nd_off = at == 0 ? nd->tn_child :
+			 btr_nd_rec_at(tcx, nd, at - 1)->rec_off;
 		next_level = true;
 		level++;
 	}
@@ -2265,6 +2337,241 @@ dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 	return btr_tx_end(tcx, rc);
 }
 
+/** A subtree created by bulk loading */
+struct btr_bulk_child {
+	/** root node of the subtree */
+	umem_off_t	bc_node;
+	/** the leftmost leaf node of the subtree */
+	umem_off_t	bc_leaf;
+};
+
+/**
+ * Check \a rec is ordered after \a prev, \a key is the key of \a rec and
+ * the hashed key of \a rec has been generated.
+ */
+static bool
+btr_bulk_ordered(struct btr_context *tcx, struct btr_record *prev,
+		 struct btr_record *rec, d_iov_t *key)
+{
+	if (btr_is_direct_key(tcx))
+		return btr_key_cmp(tcx, prev, key) == BTR_CMP_LT;
+
+	return btr_hkey_cmp(tcx, prev, &rec->rec_hkey[0]) == BTR_CMP_LT;
+}
+
+/**
+ * Free nodes created by a failed bulk load, it is only required by trees
+ * without transaction, otherwise aborting the transaction is enough.
+ */
+static void
+btr_bulk_cleanup(struct btr_context *tcx, umem_off_t *nodes, int nr)
+{
+	struct btr_node	*nd;
+	int		 i;
+	int		 j;
+
+	for (i = 0; i < nr; i++) {
+		nd = btr_off2ptr(tcx, nodes[i]);
+		if (nd->tn_flags & BTR_NODE_LEAF) {
+			for (j = 0; j < nd->tn_keyn; j++)
+				btr_rec_free(tcx,
+					     btr_node_rec_at(tcx, nodes[i], j),
+					     NULL);
+		}
+		btr_node_free(tcx, nodes[i]);
+	}
+}
+
+/**
+ * Build the tree bottom-up: fill leaves with the sorted records, then create
+ * each level of intermediate nodes for the nodes of the level below, until
+ * there is only one node which is the new root.
+ *
+ * Nodes of the same level are filled evenly instead of being packed one by
+ * one, so the last node of a level never ends up with a single child.
+ */
+static int
+btr_bulk_load(struct btr_context *tcx, unsigned int nr, d_iov_t *keys,
+	      d_iov_t *vals)
+{
+	struct btr_root		*root = tcx->tc_tins.ti_root;
+	struct btr_bulk_child	*chd;
+	struct btr_record	*rec;
+	struct btr_record	*prev = NULL;
+	struct btr_node		*nd;
+	umem_off_t		*nodes;
+	umem_off_t		 nd_off;
+	unsigned int		 chd_nr;
+	unsigned int		 nd_nr;
+	unsigned int		 cnt;
+	unsigned int		 total = 0;
+	unsigned int		 depth = 1;
+	unsigned int		 i;
+	unsigned int		 j;
+	unsigned int		 k;
+	int			 rc;
+
+	if (root->tr_node_size < nr && root->tr_node_size != tcx->tc_order) {
+		/* don't bother with growing the dynamic root */
+		if (btr_has_tx(tcx)) {
+			rc = btr_root_tx_add(tcx);
+			if (rc != 0)
+				return rc;
+		}
+		root->tr_node_size = tcx->tc_order;
+	}
+
+	/* leave room in each node so the next insert doesn't find it over full,
+	 * only a dynamic root which is smaller than the order can be filled up.
+	 */
+	cnt = root->tr_node_size == tcx->tc_order ? tcx->tc_order - 1 :
+						     root->tr_node_size;
+	nd_nr = (nr + cnt - 1) / cnt;
+	D_ALLOC_ARRAY(chd, nd_nr);
+	if (chd == NULL)
+		return -DER_NOMEM;
+
+	/* a full tree has less than twice as many nodes as its leaves */
+	D_ALLOC_ARRAY(nodes, 2 * nd_nr);
+	if (nodes == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = k = 0; i < nd_nr; i++) {
+		cnt = nr / nd_nr + (i < nr % nd_nr);
+		rc = btr_node_alloc(tcx, &nd_off);
+		if (rc != 0)
+			D_GOTO(failed, rc);
+
+		nodes[total++] = nd_off;
+		btr_node_set(tcx, nd_off, BTR_NODE_LEAF);
+		nd = btr_off2ptr(tcx, nd_off);
+
+		for (j = 0; j < cnt; j++, k++) {
+			rc = btr_verify_key(tcx, &keys[k]);
+			if (rc != 0)
+				D_GOTO(failed, rc);
+
+			rec = btr_node_rec_at(tcx, nd_off, j);
+			btr_hkey_gen(tcx, &keys[k], &rec->rec_hkey[0]);
+			if (prev != NULL &&
+			    !btr_bulk_ordered(tcx, prev, rec, &keys[k])) {
+				D_ERROR("Key %u is not in the tree order\n", k);
+				D_GOTO(failed, rc = -DER_INVAL);
+			}
+
+			rc = btr_rec_alloc(tcx, &keys[k], &vals[k], rec, NULL);
+			if (rc != 0)
+				D_GOTO(failed, rc);
+
+			nd->tn_keyn++;
+			prev = rec;
+		}
+		chd[i].bc_node = chd[i].bc_leaf = nd_off;
+	}
+
+	for (chd_nr = nd_nr; chd_nr > 1; chd_nr = nd_nr, depth++) {
+		/* non-leaf node has +1 children than number of keys, which is
+		 * less than the order
+		 */
+		nd_nr = (chd_nr + tcx->tc_order - 1) / tcx->tc_order;
+		for (i = k = 0; i < nd_nr; i++) {
+			cnt = chd_nr / nd_nr + (i < chd_nr % nd_nr);
+			D_ASSERT(cnt > 1);
+
+			rc = btr_node_alloc(tcx, &nd_off);
+			if (rc != 0)
+				D_GOTO(failed, rc);
+
+			nodes[total++] = nd_off;
+			nd = btr_off2ptr(tcx, nd_off);
+			nd->tn_child = chd[k].bc_node;
+			nd->tn_keyn = cnt - 1;
+			for (j = 1; j < cnt; j++) {
+				rec = btr_node_rec_at(tcx, nd_off, j - 1);
+				rec->rec_off = chd[k + j].bc_node;
+				/* the first key of the right subtree */
+				if (btr_is_direct_key(tcx))
+					rec->rec_node[0] = chd[k + j].bc_leaf;
+				else
+					btr_rec_copy_hkey(tcx, rec,
+						btr_node_rec_at(tcx,
+							chd[k + j].bc_leaf, 0));
+			}
+			chd[i].bc_node = nd_off;
+			chd[i].bc_leaf = chd[k].bc_leaf;
+			k += cnt;
+		}
+	}
+
+	if (btr_has_tx(tcx)) {
+		rc = btr_root_tx_add(tcx);
+		if (rc != 0)
+			D_GOTO(failed, rc);
+	}
+
+	btr_node_set(tcx, chd[0].bc_node, BTR_NODE_ROOT);
+	root->tr_node = chd[0].bc_node;
+	root->tr_depth = depth;
+	btr_context_set_depth(tcx, depth);
+
+	D_DEBUG(DB_TRACE, "Bulk loaded %u records, %u nodes, depth %u\n",
+		nr, total, depth);
+	D_GOTO(out, rc = 0);
+failed:
+	if (!btr_has_tx(tcx))
+		btr_bulk_cleanup(tcx, nodes, total);
+out:
+	D_FREE(nodes);
+	D_FREE(chd);
+	return rc;
+}
+
+/**
+ * Load sorted records into an empty tree. It is much cheaper than upserting
+ * records one by one, because records are appended to packed leaves without
+ * probing and splitting, and all records are loaded in one transaction.
+ *
+ * \param toh		[IN]	Tree open handle.
+ * \param nr		[IN]	Number of records.
+ * \param keys		[IN]	Keys of records, they must be in the order of
+ *				the tree, i.e. the order of hashed keys, or
+ *				the order of to_key_cmp for direct key tree.
+ * \param vals		[IN]	Values of records.
+ *
+ * \return		0	success
+ *			-DER_INVAL	the tree is not empty, or keys are not
+ *					in the tree order
+ *			-ve	other error code
+ */
+int
+dbtree_bulk_load(daos_handle_t toh, unsigned int nr, d_iov_t *keys,
+		 d_iov_t *vals)
+{
+	struct btr_context *tcx;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (tcx->tc_tins.ti_root == NULL || !btr_root_empty(tcx)) {
+		D_ERROR("Can only bulk load an empty tree\n");
+		return -DER_INVAL;
+	}
+
+	if (nr == 0)
+		return 0;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_bulk_load(tcx, nr, keys, vals);
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN; /* path changed */
+
+	return btr_tx_end(tcx, rc);
+}
+
 /**
  * Delete the leaf record pointed by @cur_tr from the current node, then fill
  * the deletion gap by shifting remainded records on the specified direction.
@@ -195,10 +195,41 @@ lru_del_evicted(struct daos_lru_cache *lcache,
 	D_ASSERT(llink->ll_ref == 1);
 	D_ASSERT(lcache->dlc_count > 0);
 
+	if (llink->ll_hint != 0 && lcache->dlc_hint[llink->ll_hint - 1] == llink)
+		lcache->dlc_hint[llink->ll_hint - 1] = NULL;
+	d_list_del_init(&llink->ll_qlink);
+
 	d_hash_rec_delete_at(&lcache->dlc_htable, &llink->ll_link);
 	lcache->dlc_count--;
 }
 
+/* Maximum items to be checked by CLOCK hand on each release */
+#define LRU_SWEEP_MAX	64
+
+/*
+ * Advance the CLOCK hand (head of the ring) to evict idle items until the
+ * cache is within the threshold. The referenced or busy items are given a
+ * second chance by moving them to the tail.
+ */
+static void
+lru_clock_sweep(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	*llink;
+	unsigned int		 scan = 0;
+
+	while (lcache->dlc_count > lcache->dlc_csize && scan++ < LRU_SWEEP_MAX) {
+		D_ASSERT(!d_list_empty(&lcache->dlc_lru));
+		llink = d_list_entry(lcache->dlc_lru.next, struct daos_llink, ll_qlink);
+
+		if (llink->ll_ref > 1 || llink->ll_accessed) {
+			llink->ll_accessed = 0;
+			d_list_move_tail(&llink->ll_qlink, &lcache->dlc_lru);
+			continue;
+		}
+		lru_del_evicted(lcache, llink);
+	}
+}
+
 void
 daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		     daos_lru_cond_cb_t cond, void *arg)
@@ -230,19 +261,25 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 {
 	struct daos_llink	*llink;
 	d_list_t		*link;
+	unsigned int		 slot;
 	int			 rc = 0;
 
 	D_ASSERT(lcache != NULL && key != NULL && key_size > 0);
 	if (lcache->dlc_ops->lop_print_key)
 		lcache->dlc_ops->lop_print_key(key, key_size);
 
+	slot = d_hash_string_u32((const char *)key, key_size) % DAOS_LRU_HINT_NR;
+	llink = lcache->dlc_hint[slot];
+	if (llink != NULL && !llink->ll_evicted &&
+	    lcache->dlc_ops->lop_cmp_keys(key, key_size, llink)) {
+		llink->ll_ref++;
+		D_GOTO(found, rc = 0);
+	}
+
 	link = d_hash_rec_find(&lcache->dlc_htable, key, key_size);
 	if (link != NULL) {
 		llink = link2llink(link);
 		D_ASSERT(llink->ll_evicted == 0);
-		/* remove busy item from LRU */
-		if (!d_list_empty(&llink->ll_qlink))
-			d_list_del_init(&llink->ll_qlink);
 		D_GOTO(found, rc = 0);
 	}
 
@@ -257,6 +294,7 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	D_DEBUG(DB_TRACE, "Inserting %p item into LRU Hash table\n", llink);
 	llink->ll_evicted = 0;
 	llink->ll_ref	  = 1; /* 1 for caller */
+	llink->ll_hint	  = 0;
 	llink->ll_ops	  = lcache->dlc_ops;
 	D_INIT_LIST_HEAD(&llink->ll_qlink);
 
@@ -266,8 +304,12 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		lcache->dlc_ops->lop_free_ref(llink);
 		return rc;
 	}
+	d_list_add_tail(&llink->ll_qlink, &lcache->dlc_lru);
 	lcache->dlc_count++;
 found:
+	llink->ll_accessed = 1;
+	llink->ll_hint = slot + 1;
+	lcache->dlc_hint[slot] = llink;
 	*llink_pp = llink;
 out:
 	return rc;
@@ -277,28 +319,17 @@ void
 daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 {
 	D_ASSERT(lcache != NULL && llink != NULL && llink->ll_ref > 1);
-	D_ASSERT(d_list_empty(&llink->ll_qlink));
 
 	llink->ll_ref--;
 	if (llink->ll_ref == 1) { /* the last refcount */
 		if (lcache->dlc_csize == 0)
 			llink->ll_evicted = 1;
 
-		if (llink->ll_evicted) {
+		if (llink->ll_evicted)
 			lru_del_evicted(lcache, llink);
-		} else {
-			D_ASSERT(d_list_empty(&llink->ll_qlink));
-			d_list_add(&llink->ll_qlink, &lcache->dlc_lru);
-		}
 	}
 
-	while (!d_list_empty(&lcache->dlc_lru)) {
-		llink = d_list_entry(lcache->dlc_lru.prev, struct daos_llink,
-				     ll_qlink);
-		if (lcache->dlc_count < lcache->dlc_csize)
-			break; /* within threshold and no old item */
-
-		d_list_del_init(&llink->ll_qlink);
-		lru_del_evicted(lcache, llink);
-	}
+	/* Idle items are never kept when LRU is disabled */
+	if (lcache->dlc_csize != 0 && lcache->dlc_count > lcache->dlc_csize)
+		lru_clock_sweep(lcache);
 }
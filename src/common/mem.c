@@ -27,6 +27,53 @@ struct umem_tx_stage_item {
 	void		*txi_data;
 };
 
+struct umem_node_cache_slot {
+	/** pool of the cached block */
+	uint64_t		 ncs_pool;
+	/** offset of the cached block */
+	umem_off_t		 ncs_off;
+	/** cache generation when the block is copied */
+	uint64_t		 ncs_gen;
+	/** size of the cached block */
+	size_t			 ncs_size;
+	/** size of \a ncs_buf */
+	size_t			 ncs_buf_size;
+	/** DRAM copy of the block */
+	void			*ncs_buf;
+};
+
+struct umem_node_cache {
+	struct umem_node_cache_slot	*nc_slots;
+	/** number of slots, power of 2 */
+	unsigned int			 nc_nr;
+	/** persistent memory has been modified by the current transaction */
+	bool				 nc_dirty;
+	/** bumped by the end of each modifying transaction */
+	uint64_t			 nc_gen;
+	uint64_t			 nc_hits;
+	uint64_t			 nc_misses;
+};
+
+/** node cache of the current thread (xstream) */
+static __thread struct umem_node_cache umem_nc;
+
+/** Called on modification of persistent memory */
+static inline void
+umem_node_cache_dirty(void)
+{
+	umem_nc.nc_dirty = true;
+}
+
+/** Called on transaction end, drop all copies if anything was modified */
+static inline void
+umem_node_cache_tx_end(void)
+{
+	if (umem_nc.nc_dirty) {
+		umem_nc.nc_gen++;
+		umem_nc.nc_dirty = false;
+	}
+}
+
 #ifdef DAOS_PMEM_BUILD
 /** Convert an offset to an id.   No invalid flags will be maintained
  *  in the conversion.
@@ -89,6 +136,8 @@ pmem_tx_free(struct umem_instance *umm, umem_off_t umoff)
 	if (!UMOFF_IS_NULL(umoff)) {
 		int	rc;
 
+		umem_node_cache_dirty();
+
 		rc = pmemobj_tx_free(umem_off2id(umm, umoff));
 		return rc ? umem_tx_errno(rc) : 0;
 	}
@@ -100,6 +149,7 @@ static umem_off_t
 pmem_tx_alloc(struct umem_instance *umm, size_t size, uint64_t flags,
 	      unsigned int type_num)
 {
+	umem_node_cache_dirty();
 	return umem_id2off(umm, pmemobj_tx_xalloc(size, type_num, flags));
 }
 
@@ -109,6 +159,7 @@ pmem_tx_add(struct umem_instance *umm, umem_off_t umoff,
 {
 	int	rc;
 
+	umem_node_cache_dirty();
 	rc = pmemobj_tx_add_range(umem_off2id(umm, umoff), offset, size);
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -119,6 +170,7 @@ pmem_tx_xadd(struct umem_instance *umm, umem_off_t umoff, uint64_t offset,
 {
 	int	rc;
 
+	umem_node_cache_dirty();
 	rc = pmemobj_tx_xadd_range(umem_off2id(umm, umoff), offset, size,
 				   flags);
 	return rc ? umem_tx_errno(rc) : 0;
@@ -130,6 +182,7 @@ pmem_tx_add_ptr(struct umem_instance *umm, void *ptr, size_t size)
 {
 	int	rc;
 
+	umem_node_cache_dirty();
 	rc = pmemobj_tx_add_range_direct(ptr, size);
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -145,6 +198,7 @@ pmem_tx_abort(struct umem_instance *umm, int err)
 		pmemobj_tx_abort(err);
 
 	err = pmemobj_tx_end();
+	umem_node_cache_tx_end();
 	return err ? umem_tx_errno(err) : 0;
 }
 
@@ -246,6 +300,7 @@ pmem_tx_begin(struct umem_instance *umm, struct umem_tx_stage_data *txd)
 		 * tx state when pmemobj_tx_begin() failed.
 		 */
 		rc = pmemobj_tx_end();
+		umem_node_cache_tx_end();
 		return rc ? umem_tx_errno(rc) : 0;
 	}
 	return 0;
@@ -258,6 +313,7 @@ pmem_tx_commit(struct umem_instance *umm)
 
 	pmemobj_tx_commit();
 	rc = pmemobj_tx_end();
+	umem_node_cache_tx_end();
 
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -268,15 +324,16 @@ pmem_defer_free(struct umem_instance *umm, umem_off_t off,
 {
 	PMEMoid	id = umem_off2id(umm, off);
 
+	umem_node_cache_dirty();
 	pmemobj_defer_free(umm->umm_pool, id, act);
 }
 
 static umem_off_t
 pmem_reserve(struct umem_instance *umm, struct pobj_action *act, size_t size,
-	     unsigned int type_num)
+	     uint64_t flags, unsigned int type_num)
 {
-	return umem_id2off(umm,
-			   pmemobj_reserve(umm->umm_pool, act, size, type_num));
+	return umem_id2off(umm, pmemobj_xreserve(umm->umm_pool, act, size,
+						 type_num, flags));
 }
 
 static void
@@ -291,6 +348,7 @@ pmem_tx_publish(struct umem_instance *umm, struct pobj_action *actv,
 {
 	int	rc;
 
+	umem_node_cache_dirty();
 	rc = pmemobj_tx_publish(actv, actv_cnt);
 	return rc ? umem_tx_errno(rc) : 0;
 }
@@ -503,6 +561,9 @@ umem_class_init(struct umem_attr *uma, struct umem_instance *umm)
 {
 	struct umem_class *umc;
 	bool		   found;
+#ifdef DAOS_PMEM_BUILD
+	int		   i;
+#endif
 
 	found = false;
 	for (umc = &umem_class_defined[0];
@@ -526,8 +587,10 @@ umem_class_init(struct umem_attr *uma, struct umem_instance *umm)
 	umm->umm_nospc_rc	= umc->umc_id == UMEM_CLASS_VMEM ?
 		-DER_NOMEM : -DER_NOSPACE;
 #ifdef DAOS_PMEM_BUILD
-	memcpy(umm->umm_slabs, uma->uma_slabs,
-	       sizeof(struct pobj_alloc_class_desc) * UMM_SLABS_CNT);
+	for (i = 0; i < UMM_SLABS_CNT; i++) {
+		umm->umm_slabs[i].usd_unit_size = uma->uma_slabs[i].unit_size;
+		umm->umm_slabs[i].usd_class_id = uma->uma_slabs[i].class_id;
+	}
 #endif
 
 	set_offsets(umm);
@@ -608,3 +671,85 @@ umem_fini_txd(struct umem_tx_stage_data *txd)
 		txd->txd_end_max = 0;
 	}
 }
+
+int
+umem_node_cache_init(unsigned int nr)
+{
+	D_ASSERT(umem_nc.nc_slots == NULL);
+	if (nr == 0)
+		return 0;
+
+	nr = 1U << (32 - __builtin_clz((nr - 1) | 1));
+	D_ALLOC_ARRAY(umem_nc.nc_slots, nr);
+	if (umem_nc.nc_slots == NULL)
+		return -DER_NOMEM;
+
+	umem_nc.nc_nr = nr;
+	D_DEBUG(DB_MEM, "Created node cache with %u slots\n", nr);
+	return 0;
+}
+
+void
+umem_node_cache_fini(void)
+{
+	unsigned int	i;
+
+	if (umem_nc.nc_slots == NULL)
+		return;
+
+	D_DEBUG(DB_MEM, "Node cache hits "DF_U64", misses "DF_U64"\n",
+		umem_nc.nc_hits, umem_nc.nc_misses);
+
+	for (i = 0; i < umem_nc.nc_nr; i++)
+		D_FREE(umem_nc.nc_slots[i].ncs_buf);
+
+	D_FREE(umem_nc.nc_slots);
+	memset(&umem_nc, 0, sizeof(umem_nc));
+}
+
+void *
+umem_node_cache_read(struct umem_instance *umm, umem_off_t umoff, size_t size)
+{
+#ifdef DAOS_PMEM_BUILD
+	struct umem_node_cache_slot	*slot;
+	uint64_t			 off = umem_off2offset(umoff);
+	uint64_t			 idx;
+
+	/* The persistent copy can be changed within a transaction without
+	 * bumping the cache generation.
+	 */
+	if (umem_nc.nc_nr == 0 || umm->umm_id != UMEM_CLASS_PMEM ||
+	    pmemobj_tx_stage() != TX_STAGE_NONE)
+		return umem_off2ptr(umm, umoff);
+
+	idx = ((off >> 6) ^ umm->umm_pool_uuid_lo) * 0x9e3779b97f4a7c15ULL;
+	slot = &umem_nc.nc_slots[idx >> 32 & (umem_nc.nc_nr - 1)];
+	if (slot->ncs_off == off && slot->ncs_pool == umm->umm_pool_uuid_lo &&
+	    slot->ncs_gen == umem_nc.nc_gen && slot->ncs_size == size) {
+		umem_nc.nc_hits++;
+		return slot->ncs_buf;
+	}
+
+	umem_nc.nc_misses++;
+	if (slot->ncs_buf_size < size) {
+		D_FREE(slot->ncs_buf);
+		slot->ncs_buf_size = 0;
+		slot->ncs_off = UMOFF_NULL;
+
+		D_ALLOC_NZ(slot->ncs_buf, size);
+		if (slot->ncs_buf == NULL)
+			return umem_off2ptr(umm, umoff);
+		slot->ncs_buf_size = size;
+	}
+
+	memcpy(slot->ncs_buf, umem_off2ptr(umm, umoff), size);
+	slot->ncs_pool = umm->umm_pool_uuid_lo;
+	slot->ncs_off = off;
+	slot->ncs_gen = umem_nc.nc_gen;
+	slot->ncs_size = size;
+
+	return slot->ncs_buf;
+#else
+	return umem_off2ptr(umm, umoff);
+#endif
+}
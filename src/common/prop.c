@@ -333,6 +333,13 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 				return false;
 			}
 			break;
+		case DAOS_PROP_PO_SCHED_QOS:
+			val = prop->dpp_entries[i].dpe_val;
+			if (!daos_sched_qos_valid(val)) {
+				D_ERROR("invalid pool sched qos "DF_X64".\n", val);
+				return false;
+			}
+			break;
 		case DAOS_PROP_PO_RECLAIM:
 			val = prop->dpp_entries[i].dpe_val;
 			if (val != DAOS_RECLAIM_DISABLED &&
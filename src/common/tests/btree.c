@@ -52,6 +52,7 @@ struct umem_attr		*ik_uma;
 static umem_off_t		 ik_root_off;
 static struct btr_root		*ik_root;
 static daos_handle_t		 ik_toh;
+static uint64_t			 ik_feats;
 
 
 /** integer key record */
@@ -305,6 +306,7 @@ ik_btr_open_create(void **state)
 	}
 
 	if (create) {
+		ik_feats = feats;
 		D_PRINT("Create btree with order %d%s feats "DF_X64"\n",
 			ik_order, inplace ? " inplace" : "", feats);
 		if (inplace) {
@@ -749,6 +751,223 @@ ik_btr_batch_oper(void **state)
 	D_FREE(arr);
 }
 
+static int
+ik_btr_key_cmp(const void *p1, const void *p2)
+{
+	const uint64_t	*k1 = p1;
+	const uint64_t	*k2 = p2;
+
+	/* integer key, or the hashed key which is compared by memcmp */
+	if (ik_feats & BTR_FEAT_UINT_KEY)
+		return (*k1 > *k2) - (*k1 < *k2);
+
+	return memcmp(k1, k2, sizeof(*k1));
+}
+
+/**
+ * bulk load @key_nr number of sorted even integer keys into the empty tree,
+ * then insert the odd keys in between, so every loaded node takes inserts,
+ * lookup all of them and delete all of them.
+ */
+static void
+ik_btr_bulk_load(void **state)
+{
+	uint64_t	*arr;
+	d_iov_t		*keys;
+	d_iov_t		*vals;
+	char		*vbuf;
+	char		 buf[64];
+	unsigned int	 key_nr;
+	int		 i;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 28)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(arr, key_nr);
+	D_ALLOC_ARRAY(keys, key_nr);
+	D_ALLOC_ARRAY(vals, key_nr);
+	D_ALLOC(vbuf, key_nr * 16);
+	if (arr == NULL || keys == NULL || vals == NULL || vbuf == NULL)
+		fail_msg("Array allocation failed");
+
+	for (i = 0; i < key_nr; i++)
+		arr[i] = 2 * (i + 1);
+	qsort(arr, key_nr, sizeof(*arr), ik_btr_key_cmp);
+
+	for (i = 0; i < key_nr; i++) {
+		sprintf(&vbuf[i * 16], "%d", (int)arr[i]);
+		d_iov_set(&keys[i], &arr[i], sizeof(arr[i]));
+		d_iov_set(&vals[i], &vbuf[i * 16], strlen(&vbuf[i * 16]) + 1);
+	}
+
+	if (key_nr > 1) {
+		/* unsorted keys should be rejected */
+		d_iov_set(&keys[0], &arr[1], sizeof(arr[1]));
+		rc = dbtree_bulk_load(ik_toh, key_nr, keys, vals);
+		if (rc != -DER_INVAL)
+			fail_msg("Unsorted keys were loaded: %d\n", rc);
+		if (!dbtree_is_empty(ik_toh))
+			fail_msg("Tree is not empty after failed loading\n");
+		d_iov_set(&keys[0], &arr[0], sizeof(arr[0]));
+	}
+
+	D_PRINT("Bulk load %d records.\n", key_nr);
+	rc = dbtree_bulk_load(ik_toh, key_nr, keys, vals);
+	if (rc != 0)
+		fail_msg("Failed to bulk load: %d\n", rc);
+
+	ik_btr_query(NULL);
+	for (i = 0; i < key_nr; i++) {
+		sprintf(buf, "%d", (int)arr[i]);
+		tst_fn_val.opc = BTR_OPC_LOOKUP;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = key_nr < 20;
+		ik_btr_kv_operate(NULL);
+	}
+
+	D_PRINT("Insert %d records into the loaded tree.\n", key_nr);
+	for (i = 0; i < key_nr; i++) {
+		sprintf(buf, "%d:%d", 2 * i + 1, 2 * i + 1);
+		tst_fn_val.opc = BTR_OPC_UPDATE;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = key_nr < 20;
+		ik_btr_kv_operate(NULL);
+	}
+
+	ik_btr_query(NULL);
+	for (i = 1; i <= 2 * key_nr; i++) {
+		sprintf(buf, "%d", i);
+		tst_fn_val.opc = BTR_OPC_LOOKUP;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = key_nr < 20;
+		ik_btr_kv_operate(NULL);
+	}
+
+	D_PRINT("Delete %d records.\n", 2 * key_nr);
+	for (i = 1; i <= 2 * key_nr; i++) {
+		sprintf(buf, "%d", i);
+		tst_fn_val.opc = BTR_OPC_DELETE;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = key_nr < 20;
+		ik_btr_kv_operate(NULL);
+	}
+
+	ik_btr_query(NULL);
+	if (!dbtree_is_empty(ik_toh))
+		fail_msg("Tree is not empty after deleting all records\n");
+
+	D_FREE(vbuf);
+	D_FREE(vals);
+	D_FREE(keys);
+	D_FREE(arr);
+}
+
+/* Expected key of probing @key in the tree of even keys 2, 4, ..., 2 * @key_nr */
+static uint64_t
+ik_btr_probe_expected(dbtree_probe_opc_t opc, uint64_t key, unsigned int key_nr)
+{
+	uint64_t	exp;
+
+	switch (opc) {
+	case BTR_PROBE_EQ:
+		exp = (key & 1) ? 0 : key;
+		break;
+	case BTR_PROBE_GE:
+		exp = (key & 1) ? key + 1 : key;
+		break;
+	case BTR_PROBE_GT:
+		exp = (key & 1) ? key + 1 : key + 2;
+		break;
+	case BTR_PROBE_LE:
+		exp = (key & 1) ? key - 1 : key;
+		break;
+	case BTR_PROBE_LT:
+	default:
+		exp = (key & 1) ? key - 1 : key - 2;
+		break;
+	}
+
+	/* 0 means no match */
+	return exp > 2ULL * key_nr ? 0 : exp;
+}
+
+/**
+ * Insert @key_nr even integer keys, then probe every key in the range with
+ * all the probe opcodes and verify the returned records, this covers both
+ * matched and unmatched keys at every position of the tree nodes.
+ */
+static void
+ik_btr_probe(void **state)
+{
+	static const dbtree_probe_opc_t opcs[] = {
+		BTR_PROBE_EQ, BTR_PROBE_GE, BTR_PROBE_GT, BTR_PROBE_LE, BTR_PROBE_LT,
+	};
+	unsigned int	*arr;
+	char		 buf[64];
+	d_iov_t		 key_iov;
+	d_iov_t		 key_out;
+	uint64_t	 key;
+	uint64_t	 found;
+	uint64_t	 exp;
+	unsigned int	 key_nr;
+	int		 i;
+	int		 j;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 27)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	/* Hashed keys are compared by memcmp, which isn't the integer order */
+	if (!(ik_feats & BTR_FEAT_UINT_KEY)) {
+		print_message("Skip probe test for non-integer keys\n");
+		return;
+	}
+
+	D_ALLOC_ARRAY(arr, key_nr);
+	if (arr == NULL)
+		fail_msg("Array allocation failed");
+
+	D_PRINT("Batch add %d records.\n", key_nr);
+	ik_btr_gen_keys(arr, key_nr);
+	for (i = 0; i < key_nr; i++) {
+		sprintf(buf, "%u:%u", arr[i] * 2, arr[i] * 2);
+		tst_fn_val.opc = BTR_OPC_UPDATE;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = false;
+		ik_btr_kv_operate(NULL);
+	}
+
+	D_PRINT("Probe %d keys.\n", key_nr * 2 + 1);
+	for (key = 1; key <= 2ULL * key_nr + 1; key++) {
+		for (j = 0; j < ARRAY_SIZE(opcs); j++) {
+			exp = ik_btr_probe_expected(opcs[j], key, key_nr);
+			found = 0;
+			d_iov_set(&key_iov, &key, sizeof(key));
+			d_iov_set(&key_out, &found, sizeof(found));
+			rc = dbtree_fetch(ik_toh, opcs[j], DAOS_INTENT_DEFAULT,
+					  &key_iov, &key_out, NULL);
+			if (exp == 0 && rc == -DER_NONEXIST)
+				continue;
+			if (rc != 0)
+				fail_msg("Probe "DF_U64" with opc %d failed: %d, expected "
+					 DF_U64"\n", key, opcs[j], rc, exp);
+			if (found != exp)
+				fail_msg("Probe "DF_U64" with opc %d returned "DF_U64
+					 ", expected "DF_U64"\n", key, opcs[j], found, exp);
+		}
+	}
+
+	D_FREE(arr);
+	print_message("Test Passed\n");
+}
+
 static void
 ik_btr_perf(void **state)
 {
@@ -880,6 +1099,8 @@ static struct option btr_ops[] = {
 	{ "iterate",	required_argument,	NULL,	'i'	},
 	{ "batch",	required_argument,	NULL,	'b'	},
 	{ "perf",	required_argument,	NULL,	'p'	},
+	{ "bulk",	required_argument,	NULL,	'l'	},
+	{ "probe",	required_argument,	NULL,	'g'	},
 	{ NULL,		0,			NULL,	0	},
 };
 
@@ -904,7 +1125,7 @@ ts_group(void **state) {
 
 	while ((opt = getopt_long(test_group_stop-test_group_start+1,
 				  test_group_args+test_group_start,
-				  "tmC:Deocqu:d:r:f:i:b:p:",
+				  "tmC:Deocqu:d:r:f:i:b:p:l:g:",
 				  btr_ops,
 				  NULL)) != -1) {
 		tst_fn_val.optval = optarg;
@@ -958,6 +1179,12 @@ ts_group(void **state) {
 		case 'p':
 			ik_btr_perf(st);
 			break;
+		case 'l':
+			ik_btr_bulk_load(st);
+			break;
+		case 'g':
+			ik_btr_probe(st);
+			break;
 		default:
 			D_PRINT("Unsupported command %c\n", opt);
 		case 'm':
@@ -1035,7 +1262,7 @@ main(int argc, char **argv)
 		test_name = "Btree testing tool";
 		optind = 0;
 		/* Check for -m option first */
-		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:p:",
+		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:p:l:",
 					  btr_ops, NULL)) != -1) {
 			if (opt == 'm') {
 				rc = use_pmem();
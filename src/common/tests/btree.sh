@@ -127,12 +127,28 @@ run_test()
         -b "$BAT_NUM"                               \
         -D
 
+        echo "B+tree bulk load test..."
+        eval "${VCMD[@]}" "$BTR" \
+        --start-test "btree bulk load ${test_conf_pre} ${test_conf}" \
+        "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+        -l "$BAT_NUM"                               \
+        -D
+
         echo "B+tree drain test..."
         eval "${VCMD[@]}" "$BTR" \
         --start-test "btree drain ${test_conf_pre} ${test_conf}" \
         "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
         -e -D
 
+        if [ -n "${UINT}" ]; then
+            echo "B+tree probe test..."
+            eval "${VCMD[@]}" "$BTR" \
+            --start-test "btree probe ${test_conf_pre} ${test_conf}" \
+            "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+            -g "$BAT_NUM"                               \
+            -D
+        fi
+
     else
         echo "B+tree performance test..."
         eval "${VCMD[@]}" "$BTR" \
@@ -221,6 +221,45 @@ func PoolProperties() PoolPropertyMap {
 				jsonNumeric: true,
 			},
 		},
+		"sched_qos": {
+			Property: PoolProperty{
+				Number:      daos.PoolPropertySchedQos,
+				Description: "I/O scheduling weight[:per-target IOPS limit]",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					qosErr := errors.Errorf("invalid sched_qos value %q (valid: weight[:iops], weight 1-65535)", s)
+					fields := strings.Split(s, ":")
+					if len(fields) > 2 {
+						return nil, qosErr
+					}
+					weight, err := strconv.ParseUint(fields[0], 10, 16)
+					if err != nil {
+						return nil, qosErr
+					}
+					var iops uint64
+					if len(fields) == 2 {
+						iops, err = strconv.ParseUint(fields[1], 10, 32)
+						if err != nil {
+							return nil, qosErr
+						}
+					}
+					qos, ok := daos.SchedQos(weight, iops)
+					if !ok {
+						return nil, qosErr
+					}
+					return &PoolPropertyValue{qos}, nil
+				},
+				valueStringer: func(v *PoolPropertyValue) string {
+					n, err := v.GetNumber()
+					if err != nil {
+						return "not set"
+					}
+					if daos.SchedQosIops(n) == 0 {
+						return fmt.Sprintf("%d", daos.SchedQosWeight(n))
+					}
+					return fmt.Sprintf("%d:%d", daos.SchedQosWeight(n), daos.SchedQosIops(n))
+				},
+			},
+		},
 		"upgrade_status": {
 			Property: PoolProperty{
 				Number:      daos.PoolPropertyUpgradeStatus,
@@ -195,6 +195,28 @@ func TestControl_PoolProperties(t *testing.T) {
 			value:  "-1",
 			expErr: errors.New("invalid"),
 		},
+		"sched_qos-weight": {
+			name:    "sched_qos",
+			value:   "4",
+			expStr:  "sched_qos:4",
+			expJson: []byte(`{"name":"sched_qos","description":"I/O scheduling weight[:per-target IOPS limit]","value":"4"}`),
+		},
+		"sched_qos-weight-iops": {
+			name:    "sched_qos",
+			value:   "2:1000",
+			expStr:  "sched_qos:2:1000",
+			expJson: []byte(`{"name":"sched_qos","description":"I/O scheduling weight[:per-target IOPS limit]","value":"2:1000"}`),
+		},
+		"sched_qos-zero-weight": {
+			name:   "sched_qos",
+			value:  "0:1000",
+			expErr: errors.New("invalid"),
+		},
+		"sched_qos-invalid": {
+			name:   "sched_qos",
+			value:  "1:2:3",
+			expErr: errors.New("invalid"),
+		},
 		"policy-valid": {
 			name:    "policy",
 			value:   "type=io_size",
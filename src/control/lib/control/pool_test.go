@@ -1045,6 +1045,10 @@ func TestPoolGetProp(t *testing.T) {
 							Number: propWithVal("policy", "").Number,
 							Value:  &mgmtpb.PoolProperty_Strval{"type=io_size"},
 						},
+						{
+							Number: propWithVal("sched_qos", "").Number,
+							Value:  &mgmtpb.PoolProperty_Numval{2 | 1000<<16},
+						},
 					},
 				}),
 			},
@@ -1060,6 +1064,7 @@ func TestPoolGetProp(t *testing.T) {
 				propWithVal("reclaim", "disabled"),
 				propWithVal("rf", "1"),
 				propWithVal("rp_pda", "2"),
+				propWithVal("sched_qos", "2:1000"),
 				propWithVal("self_heal", "exclude"),
 				propWithVal("space_rb", "42"),
 				propWithVal("upgrade_status", "in progress"),
@@ -101,6 +101,8 @@ const (
 	PoolPropertyGlobalVersion = C.DAOS_PROP_PO_GLOBAL_VERSION
 	//PoolPropertyUpgradeStatus is pool upgrade status
 	PoolPropertyUpgradeStatus = C.DAOS_PROP_PO_UPGRADE_STATUS
+	//PoolPropertySchedQos is pool I/O scheduling weight and IOPS limit
+	PoolPropertySchedQos = C.DAOS_PROP_PO_SCHED_QOS
 )
 
 const (
@@ -194,6 +196,26 @@ func RpPdaIsValid(pda uint64) bool {
 	return bool(C.daos_rp_pda_valid(C.uint32_t(pda)))
 }
 
+// SchedQos packs the pool I/O scheduling weight and per-target IOPS limit
+// (0 means no limit) into a DAOS_PROP_PO_SCHED_QOS property value.
+func SchedQos(weight, iops uint64) (uint64, bool) {
+	if weight > math.MaxUint16 || iops > math.MaxUint32 {
+		return 0, false
+	}
+	qos := iops<<16 | weight
+	return qos, bool(C.daos_sched_qos_valid(C.uint64_t(qos)))
+}
+
+// SchedQosWeight returns the pool I/O scheduling weight of a packed QoS value.
+func SchedQosWeight(qos uint64) uint64 {
+	return qos & math.MaxUint16
+}
+
+// SchedQosIops returns the per-target IOPS limit of a packed QoS value.
+func SchedQosIops(qos uint64) uint64 {
+	return (qos >> 16) & math.MaxUint32
+}
+
 // PoolPolicy defines a type to be used to represent DAOS pool policies.
 type PoolPolicy uint32
 
@@ -23,6 +23,7 @@ uint32_t dtx_agg_thd_cnt_lo;
 uint32_t dtx_agg_thd_age_up;
 uint32_t dtx_agg_thd_age_lo;
 uint32_t dtx_batched_ult_max;
+bool dtx_cos_piggyback;
 
 
 struct dtx_batched_pool_args {
@@ -50,6 +51,18 @@ struct dtx_batched_cont_args {
 	struct dtx_batched_pool_args	*dbca_pool;
 	int				 dbca_refs;
 	uint32_t			 dbca_reg_gen;
+	/* Committable count and age (in second) thresholds for triggering batched commit. */
+	uint32_t			 dbca_batch_cnt;
+	uint32_t			 dbca_batch_age;
+	/* The last sample time (in ms) and related counters for the commit controller. */
+	uint64_t			 dbca_ctl_ts;
+	uint64_t			 dbca_ctl_added;
+	uint64_t			 dbca_ctl_hits;
+	/* Smoothed DTX prepare rate and DTX_REFRESH hit rate, per second. */
+	uint64_t			 dbca_prep_rate;
+	uint64_t			 dbca_hit_rate;
+	/* Smoothed batched commit latency (in us). */
+	uint64_t			 dbca_cmt_lat;
 	uint32_t			 dbca_deregister:1,
 					 dbca_cleanup_done:1,
 					 dbca_commit_done:1,
@@ -468,6 +481,92 @@ dtx_aggregation_main(void *arg)
 	dmi->dmi_dtx_agg_req = NULL;
 }
 
+static inline bool
+dtx_batched_need_commit(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	if (stat->dtx_committable_count > dbca->dbca_batch_cnt)
+		return true;
+
+	return stat->dtx_oldest_committable_time != 0 &&
+	       dtx_hlc_age2sec(stat->dtx_oldest_committable_time) >= dbca->dbca_batch_age;
+}
+
+static inline void
+dtx_batched_lat_update(struct dtx_batched_cont_args *dbca, uint64_t lat)
+{
+	if (dbca->dbca_cmt_lat == 0)
+		dbca->dbca_cmt_lat = lat;
+	else
+		dbca->dbca_cmt_lat = (dbca->dbca_cmt_lat * 7 + lat) >> 3;
+}
+
+/*
+ * Adjust the batched commit thresholds for the container based on the observed DTX prepare
+ * rate, the batched commit latency and the count of DTX_REFRESH hits from blocked readers.
+ *
+ * The count threshold is sized to cover the DTXs prepared during two commit RPCs, so that
+ * batched commit keeps pace with the prepare without sending too small RPCs. If readers are
+ * blocked by non-committed DTXs, then both count and age thresholds are reduced to commit
+ * them sooner, the more hits, the more reduction.
+ */
+static void
+dtx_batched_ctl_update(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	struct ds_cont_child	*cont = dbca->dbca_cont;
+	struct dtx_pool_metrics	*dpm;
+	uint64_t		 now = daos_getmtime_coarse();
+	uint64_t		 intvl;
+	uint64_t		 rate;
+	uint64_t		 cnt;
+	uint32_t		 shift;
+
+	intvl = now - dbca->dbca_ctl_ts;
+	if (intvl < DTX_BATCH_SAMPLE_INTVL)
+		return;
+
+	if (dbca->dbca_ctl_ts != 0) {
+		rate = (cont->sc_dtx_cos_added - dbca->dbca_ctl_added) * 1000 / intvl;
+		dbca->dbca_prep_rate = (dbca->dbca_prep_rate + rate) >> 1;
+		rate = (cont->sc_dtx_refresh_hits - dbca->dbca_ctl_hits) * 1000 / intvl;
+		dbca->dbca_hit_rate = (dbca->dbca_hit_rate + rate) >> 1;
+	}
+
+	dbca->dbca_ctl_ts = now;
+	dbca->dbca_ctl_added = cont->sc_dtx_cos_added;
+	dbca->dbca_ctl_hits = cont->sc_dtx_refresh_hits;
+
+	/* Keep the default count threshold until the first batched commit latency sample. */
+	if (dbca->dbca_cmt_lat == 0)
+		cnt = DTX_THRESHOLD_COUNT;
+	else
+		cnt = dbca->dbca_prep_rate * dbca->dbca_cmt_lat * 2 / 1000000;
+	for (shift = 0; shift < DTX_BATCH_SHIFT_MAX &&
+	     (dbca->dbca_hit_rate >> (shift << 2)) != 0; shift++)
+		;
+
+	cnt >>= shift;
+	if (cnt < DTX_BATCH_CNT_MIN)
+		cnt = DTX_BATCH_CNT_MIN;
+	else if (cnt > DTX_THRESHOLD_COUNT)
+		cnt = DTX_THRESHOLD_COUNT;
+
+	dbca->dbca_batch_cnt = cnt;
+	dbca->dbca_batch_age = max(DTX_COMMIT_THRESHOLD_AGE >> shift, DTX_BATCH_AGE_MIN);
+
+	dpm = cont->sc_pool->spc_metrics[DAOS_DTX_MODULE];
+	if (dpm == NULL)
+		return;
+
+	d_tm_set_gauge(dpm->dpm_batch_size, dbca->dbca_batch_cnt);
+	if (stat->dtx_oldest_committable_time != 0 &&
+	    crt_hlc_get() > stat->dtx_oldest_committable_time)
+		d_tm_set_gauge(dpm->dpm_commit_lag,
+			       crt_hlc2nsec(crt_hlc_get() - stat->dtx_oldest_committable_time) /
+			       NSEC_PER_MSEC);
+	else
+		d_tm_set_gauge(dpm->dpm_commit_lag, 0);
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
@@ -489,6 +588,7 @@ dtx_batched_commit_one(void *arg)
 		struct dtx_stat		  stat = { 0 };
 		int			  cnt;
 		int			  rc;
+		uint64_t		  start;
 
 		cnt = dtx_fetch_committable(cont, DTX_THRESHOLD_COUNT, NULL,
 					    DAOS_EPOCH_MAX, &dtes, &dcks);
@@ -501,8 +601,10 @@ dtx_batched_commit_one(void *arg)
 			break;
 		}
 
+		start = daos_getutime();
 		rc = dtx_commit(cont, dtes, dcks, cnt, 0);
 		dtx_free_committable(dtes, dcks, cnt);
+		dtx_batched_lat_update(dbca, daos_getutime() - start);
 		if (rc != 0) {
 			D_WARN("Fail to batched commit %d entries for "DF_UUID": "DF_RC"\n",
 			       cnt, DP_UUID(cont->sc_uuid), DP_RC(rc));
@@ -515,10 +617,7 @@ dtx_batched_commit_one(void *arg)
 		    dbca->dbca_pool->dbpa_aggregating == 0)
 			sched_req_wakeup(dmi->dmi_dtx_agg_req);
 
-		if ((stat.dtx_committable_count <= DTX_THRESHOLD_COUNT) &&
-		    (stat.dtx_oldest_committable_time == 0 ||
-		     dtx_hlc_age2sec(stat.dtx_oldest_committable_time) <
-		     DTX_COMMIT_THRESHOLD_AGE))
+		if (!dtx_batched_need_commit(dbca, &stat))
 			break;
 	}
 
@@ -571,6 +670,9 @@ dtx_batched_commit(void *arg)
 		d_list_move_tail(&dbca->dbca_sys_link,
 				 &dmi->dmi_dtx_batched_cont_open_list);
 		dtx_stat(cont, &stat);
+		dtx_batched_ctl_update(dbca, &stat);
+		if (dtx_cont_opened(cont) && vos_dtx_cmt_bloom_grow(cont->sc_hdl) > 0)
+			sleep_time = 0;
 
 		if (dbca->dbca_commit_req != NULL && dbca->dbca_commit_done) {
 			sched_req_put(dbca->dbca_commit_req);
@@ -580,10 +682,7 @@ dtx_batched_commit(void *arg)
 
 		if (dtx_cont_opened(cont) && dbca->dbca_commit_req == NULL &&
 		    (dtx_batched_ult_max != 0 && tls->dt_batched_ult_cnt < dtx_batched_ult_max) &&
-		    ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
-		     (stat.dtx_oldest_committable_time != 0 &&
-		      dtx_hlc_age2sec(stat.dtx_oldest_committable_time) >=
-		      DTX_COMMIT_THRESHOLD_AGE))) {
+		    dtx_batched_need_commit(dbca, &stat)) {
 			D_ASSERT(!dbca->dbca_commit_done);
 			sleep_time = 0;
 			dtx_get_dbca(dbca);
@@ -1602,6 +1701,8 @@ dtx_cont_register(struct ds_cont_child *cont)
 	dbca->dbca_cont = cont;
 	dbca->dbca_pool = dbpa;
 	dbca->dbca_agg_gen = tls->dt_agg_gen;
+	dbca->dbca_batch_cnt = DTX_THRESHOLD_COUNT;
+	dbca->dbca_batch_age = DTX_COMMIT_THRESHOLD_AGE;
 	d_list_add_tail(&dbca->dbca_sys_link, &dmi->dmi_dtx_batched_cont_close_list);
 	d_list_add_tail(&dbca->dbca_pool_link, &dbpa->dbpa_cont_list);
 	if (new_pool)
@@ -133,6 +133,7 @@ dtx_cos_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 	d_list_add_tail(&dcrc->dcrc_gl_committable,
 			&cont->sc_dtx_cos_list);
 	cont->sc_dtx_committable_count++;
+	cont->sc_dtx_cos_added++;
 	d_tm_inc_gauge(tls->dt_committable, 1);
 
 	if (rbund->flags & DCF_EXP_CMT) {
@@ -238,6 +239,7 @@ dtx_cos_rec_update(struct btr_instance *tins, struct btr_record *rec,
 	d_list_add_tail(&dcrc->dcrc_gl_committable,
 			&cont->sc_dtx_cos_list);
 	cont->sc_dtx_committable_count++;
+	cont->sc_dtx_cos_added++;
 	d_tm_inc_gauge(tls->dt_committable, 1);
 
 	if (rbund->flags & DCF_EXP_CMT) {
@@ -343,7 +345,13 @@ dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 		return rc == -DER_NONEXIST ? 0 : rc;
 
 	dcr = (struct dtx_cos_rec *)riov.iov_buf;
-	if (dcr->dcr_prio_count == 0)
+	count = dcr->dcr_prio_count;
+	/* In piggyback mode, the regular committable DTXs against the same object and
+	 * dkey will be committed via the dispatched RPC to the same targets too.
+	 */
+	if (dtx_cos_piggyback)
+		count += dcr->dcr_reg_count;
+	if (count == 0)
 		return 0;
 
 	/* There are too many priority DTXs to be committed, as to cannot be
@@ -351,18 +359,29 @@ dtx_list_cos(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 	 * DTXs. If some DTX in the left part caused current modification
 	 * failure (conflict), related RPC will be retried sometime later.
 	 */
-	if (dcr->dcr_prio_count > max)
+	if (count > max)
 		count = max;
-	else
-		count = dcr->dcr_prio_count;
 
 	D_ALLOC_ARRAY(dti, count);
 	if (dti == NULL)
 		return -DER_NOMEM;
 
-	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link)
+	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
 		dti[i++] = dcrc->dcrc_dte->dte_xid;
+		if (i >= count)
+			goto out;
+	}
 
+	/* The left ones will be committed via batched commit after some time. */
+	if (dtx_cos_piggyback) {
+		d_list_for_each_entry(dcrc, &dcr->dcr_reg_list, dcrc_lo_link) {
+			dti[i++] = dcrc->dcrc_dte->dte_xid;
+			if (i >= count)
+				break;
+		}
+	}
+
+out:
 	D_ASSERT(i == count);
 	*dtis = dti;
 
@@ -141,6 +141,24 @@ extern uint32_t dtx_agg_thd_age_lo;
  */
 extern uint32_t dtx_batched_ult_max;
 
+/*
+ * The batched commit controller adjusts per-container commit trigger within these bounds
+ * based on the prepare rate, the commit RPC latency and DTX_REFRESH hits from readers.
+ */
+#define DTX_BATCH_CNT_MIN	(DTX_THRESHOLD_COUNT >> 4)
+#define DTX_BATCH_AGE_MIN	1
+/* The interval (in ms) for sampling the batched commit controller inputs. */
+#define DTX_BATCH_SAMPLE_INTVL	1000
+/* Each level halves the commit threshold when readers are blocked by non-committed DTXs. */
+#define DTX_BATCH_SHIFT_MAX	3
+
+/*
+ * Whether piggyback the regular committable DTXs (besides the shared ones) via the dispatched
+ * update/punch RPC against the same object and dkey. The left ones will still be committed via
+ * DTX batched commit. It can be enabled via the environment "DAOS_DTX_PIGGYBACK".
+ */
+extern bool dtx_cos_piggyback;
+
 /* The threshold for using helper ULT when handle DTX RPC. */
 #define DTX_RPC_HELPER_THD_MIN	18
 #define DTX_RPC_HELPER_THD_DEF	(DTX_THRESHOLD_COUNT + 1)
@@ -150,6 +168,8 @@ extern uint32_t dtx_rpc_helper_thd;
 struct dtx_pool_metrics {
 	struct d_tm_node_t	*dpm_batched_degree;
 	struct d_tm_node_t	*dpm_batched_total;
+	struct d_tm_node_t	*dpm_batch_size;
+	struct d_tm_node_t	*dpm_commit_lag;
 	struct d_tm_node_t	*dpm_total[DTX_PROTO_SRV_RPC_COUNT];
 };
 
@@ -232,6 +232,69 @@ out:
 		din != NULL ? din->di_epoch : 0, drr->drr_result);
 }
 
+/*
+ * Commit the DTXs on the sibling target of current engine directly via ULT on related
+ * xstream instead of sending DTX_COMMIT RPC to ourselves.
+ */
+static void
+dtx_req_local_commit(void *arg)
+{
+	struct dtx_req_rec	*drr = arg;
+	struct dtx_req_args	*dra = drr->drr_parent;
+	struct dtx_pool_metrics	*dpm;
+	struct ds_cont_child	*cont = NULL;
+	uint64_t		 opc_cnt = 0;
+	uint64_t		 ent_cnt = 0;
+	int			 count = DTX_YIELD_CYCLE;
+	int			 i = 0;
+	int			 rc;
+	int			 rc1;
+
+	rc = ds_cont_child_lookup(dra->dra_po_uuid, dra->dra_co_uuid, &cont);
+	if (rc != 0)
+		goto out;
+
+	dpm = cont->sc_pool->spc_metrics[DAOS_DTX_MODULE];
+
+	if (DAOS_FAIL_CHECK(DAOS_DTX_MISS_COMMIT))
+		goto out;
+
+	while (i < drr->drr_count) {
+		if (i + count > drr->drr_count)
+			count = drr->drr_count - i;
+
+		rc1 = vos_dtx_commit(cont->sc_hdl, &drr->drr_dti[i], count, NULL);
+		if (rc == 0 && rc1 < 0)
+			rc = rc1;
+
+		i += count;
+	}
+
+	/* Same accounting as the DTX_COMMIT handler */
+	d_tm_inc_counter(dpm->dpm_batched_total, drr->drr_count);
+	rc1 = d_tm_get_counter(NULL, &ent_cnt, dpm->dpm_batched_total);
+	D_ASSERT(rc1 == DER_SUCCESS);
+
+	rc1 = d_tm_get_counter(NULL, &opc_cnt, dpm->dpm_total[DTX_COMMIT]);
+	D_ASSERT(rc1 == DER_SUCCESS);
+
+	d_tm_set_gauge(dpm->dpm_batched_degree, ent_cnt / (opc_cnt + 1));
+	d_tm_inc_counter(dpm->dpm_total[DTX_COMMIT], 1);
+
+out:
+	if (cont != NULL)
+		ds_cont_child_put(cont);
+
+	D_DEBUG(DB_TRACE, "DTX local commit for "DF_DTI" on tgt %d, count %d: rc %d\n",
+		DP_DTI(drr->drr_dti), drr->drr_tag, drr->drr_count, rc);
+
+	drr->drr_comp = 1;
+	drr->drr_result = rc;
+	rc = ABT_future_set(dra->dra_future, drr);
+	D_ASSERTF(rc == ABT_SUCCESS, "ABT_future_set failed for local commit on %d/%d: rc = %d.\n",
+		  drr->drr_rank, drr->drr_tag, rc);
+}
+
 static int
 dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
 {
@@ -242,6 +305,11 @@ dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
 	struct dtx_in		*din = NULL;
 	int			 rc;
 
+	/* The participant on the same engine does not need DTX_COMMIT RPC. */
+	if (dra->dra_opc == DTX_COMMIT && drr->drr_rank == dss_self_rank() &&
+	    dss_ult_create(dtx_req_local_commit, drr, DSS_XS_VOS, drr->drr_tag, 0, NULL) == 0)
+		return 0;
+
 	tgt_ep.ep_grp = NULL;
 	tgt_ep.ep_rank = drr->drr_rank;
 	tgt_ep.ep_tag = daos_rpc_tag(DAOS_REQ_TGT, drr->drr_tag);
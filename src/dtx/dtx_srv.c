@@ -95,6 +95,21 @@ dtx_metrics_alloc(const char *path, int tgt_id)
 		D_WARN("Failed to create DTX batched total metric: "DF_RC"\n",
 		       DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->dpm_batch_size, D_TM_STATS_GAUGE,
+			     "adaptive committable threshold for DTX batched commit",
+			     "entries", "%s/entries/dtx_batch_size/tgt_%u",
+			     path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX batch size metric: "DF_RC"\n",
+		       DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->dpm_commit_lag, D_TM_STATS_GAUGE,
+			     "age of the oldest committable DTX entry per container",
+			     "ms", "%s/dtx_commit_lag/tgt_%u", path, tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit lag metric: "DF_RC"\n",
+		       DP_RC(rc));
+
 	/** Register different per-opcode counters */
 	for (opc = 0; opc < DTX_PROTO_SRV_RPC_COUNT; opc++) {
 		rc = d_tm_add_metric(&metrics->dpm_total[opc], D_TM_COUNTER,
@@ -283,6 +298,10 @@ dtx_handler(crt_rpc_t *rpc)
 				*ptr = DTX_ST_PREPARED;
 			}
 
+			/* Someone is blocked by the DTX that is not committed yet. */
+			if (*ptr == DTX_ST_PREPARED || *ptr == DTX_ST_COMMITTABLE)
+				cont->sc_dtx_refresh_hits++;
+
 			if (mbs[i] != NULL)
 				rc1++;
 		}
@@ -395,6 +414,11 @@ dtx_init(void)
 	d_getenv_int("DAOS_DTX_BATCHED_ULT_MAX", &dtx_batched_ult_max);
 	D_INFO("Set the max count of DTX batched commit ULTs as %d\n", dtx_batched_ult_max);
 
+	dtx_cos_piggyback = false;
+	d_getenv_bool("DAOS_DTX_PIGGYBACK", &dtx_cos_piggyback);
+	D_INFO("%s DTX commit piggyback via dispatched RPC\n",
+	       dtx_cos_piggyback ? "Enable" : "Disable");
+
 	rc = dbtree_class_register(DBTREE_CLASS_DTX_CF,
 				   BTR_FEAT_UINT_KEY | BTR_FEAT_DYNAMIC_ROOT,
 				   &dbtree_dtx_cf_ops);
@@ -138,12 +138,30 @@ struct sched_pool_info {
 	int			spi_ref;
 	uint32_t		spi_req_cnt;
 	struct stats_window	spi_stats_window;
+	/* Link to 'sched_info->si_rr_list' when there are pending IO requests */
+	d_list_t		spi_rr_link;
+	/* DRR deficit of SCHED_POLICY_ID_RR, in request weights */
+	uint64_t		spi_deficit;
+	/* Available IOPS tokens and last token refill time (msecs) */
+	uint64_t		spi_iops_tokens;
+	uint64_t		spi_iops_ts;
+	/* Pool QoS weight and per-target IOPS limit (0: unlimited) */
+	uint32_t		spi_weight;
+	uint32_t		spi_iops_max;
+	/* IO request type to be served next in SCHED_POLICY_ID_RR */
+	unsigned int		spi_io_type;
+	/* Per-pool metrics, only created for SCHED_POLICY_ID_RR */
+	struct d_tm_node_t	*spi_queue_depth;
+	struct d_tm_node_t	*spi_wait_time;
+	uint32_t		spi_xs_id;
+	bool			spi_metrics;
 };
 
 struct sched_request {
 	/*
-	 * IO request links to 'sched_info->si_fifo_list', other types of
-	 * request link to each 'sched_req_info->sri_req_list' respectively.
+	 * IO request links to 'sched_info->si_fifo_list' on FIFO policy, other
+	 * types of request (or IO request on pool RR policy) link to each
+	 * 'sched_req_info->sri_req_list' respectively.
 	 * When request is not used, it's in 'sched_info->si_idle_list'.
 	 */
 	d_list_t		 sr_link;
@@ -156,6 +174,8 @@ struct sched_request {
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
 	uint64_t		 sr_enqueue_ts;
+	/* When the request is expected to be kicked off, in msecs */
+	uint64_t		 sr_deadline;
 	unsigned int		 sr_abort:1,
 				 /* sr_ult is sched_request-owned */
 				 sr_owned:1;
@@ -166,24 +186,9 @@ unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
-
-enum {
-	/* All requests for various pools are processed in FIFO */
-	SCHED_POLICY_FIFO	= 0,
-	/*
-	 * All requests are processed in RR based on certain ID (Client ID,
-	 * Pool ID, Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_RR,
-	/*
-	 * Request priority is based on certain ID (Client ID, Pool ID,
-	 * Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_PRIO,
-	SCHED_POLICY_MAX
-};
-
-static int	sched_policy;
+unsigned int	sched_policy = SCHED_POLICY_FIFO;
+/* Fetch queued time target (msecs) of the latency SLO mode, 0: disabled */
+unsigned int	sched_fetch_slo;
 
 /*
  * Time threshold for giving IO up throttling. If space pressure stays in the
@@ -322,6 +327,54 @@ is_spi_inuse(struct sched_pool_info *spi)
 	return spi->spi_req_cnt != 0 || spi->spi_gc_ults != 0;
 }
 
+#define SCHED_POOL_METRICS_SZ	(8 * 1024)
+
+static void
+spi_metrics_init(struct dss_xstream *dx, struct sched_pool_info *spi)
+{
+	int	rc;
+
+	/* Per-pool metrics are only interesting when pools are scheduled separately */
+	if (sched_policy != SCHED_POLICY_ID_RR || !dx->dx_main_xs)
+		return;
+
+	rc = d_tm_add_ephemeral_dir(NULL, SCHED_POOL_METRICS_SZ, "sched/pool/"DF_UUIDF"/xs_%u",
+				    DP_UUID(spi->spi_pool_id), dx->dx_xs_id);
+	if (rc) {
+		D_WARN("Failed to create sched pool metrics dir: "DF_RC"\n", DP_RC(rc));
+		return;
+	}
+	spi->spi_xs_id = dx->dx_xs_id;
+	spi->spi_metrics = true;
+
+	rc = d_tm_add_metric(&spi->spi_queue_depth, D_TM_GAUGE, "Queued IO requests", "req",
+			     "sched/pool/"DF_UUIDF"/xs_%u/queue_depth", DP_UUID(spi->spi_pool_id),
+			     dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create queue_depth telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&spi->spi_wait_time, D_TM_STATS_GAUGE, "IO request queued time",
+			     "ms", "sched/pool/"DF_UUIDF"/xs_%u/wait_time",
+			     DP_UUID(spi->spi_pool_id), dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create wait_time telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+static void
+spi_metrics_fini(struct sched_pool_info *spi)
+{
+	int	rc;
+
+	if (!spi->spi_metrics)
+		return;
+
+	rc = d_tm_del_ephemeral_dir("sched/pool/"DF_UUIDF"/xs_%u", DP_UUID(spi->spi_pool_id),
+				    spi->spi_xs_id);
+	if (rc)
+		D_WARN("Failed to delete sched pool metrics dir: "DF_RC"\n", DP_RC(rc));
+	spi->spi_metrics = false;
+}
+
 static void
 spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 {
@@ -345,7 +398,9 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 			  type, pool2req_cnt(spi, type));
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
+	D_ASSERT(d_list_empty(&spi->spi_rr_link));
 
+	spi_metrics_fini(spi);
 	D_FREE(spi);
 }
 
@@ -451,6 +506,7 @@ sched_info_fini(struct dss_xstream *dx)
 	D_ASSERT(info->si_req_cnt == 0);
 	D_ASSERT(d_list_empty(&info->si_sleep_list));
 	D_ASSERT(d_list_empty(&info->si_fifo_list));
+	D_ASSERT(d_list_empty(&info->si_rr_list));
 
 	prune_purge_list(dx);
 
@@ -528,6 +584,128 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_poll_time[SCHED_POLL_BUSY], D_TM_COUNTER,
+			     "Time spent in busy polling", "ms", "sched/poll_busy/xs_%u",
+			     dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create poll_busy telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_poll_time[SCHED_POLL_SPIN], D_TM_COUNTER,
+			     "Time spent in short relaxing", "ms", "sched/poll_spin/xs_%u",
+			     dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create poll_spin telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_poll_time[SCHED_POLL_WAIT], D_TM_COUNTER,
+			     "Time spent in event waiting", "ms", "sched/poll_wait/xs_%u",
+			     dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create poll_wait telemetry: "DF_RC"\n", DP_RC(rc));
+
+	/* Only VOS xstreams serve IO requests */
+	if (!dx->dx_main_xs)
+		return;
+
+	memset(stats->ss_wait_bkts, 0, sizeof(stats->ss_wait_bkts));
+	stats->ss_wait_ts = info->si_cur_ts;
+	stats->ss_fetch_p99_ms = 0;
+
+	rc = d_tm_add_metric(&stats->ss_fetch_wait, D_TM_STATS_GAUGE, "Fetch queued time", "ms",
+			     "sched/fetch_wait/xs_%u", dx->dx_xs_id);
+	if (rc == 0) {
+		char	path[D_TM_MAX_NAME_LEN];
+
+		snprintf(path, sizeof(path), "sched/fetch_wait/xs_%u", dx->dx_xs_id);
+		rc = d_tm_init_histogram(stats->ss_fetch_wait, path, SCHED_WAIT_BKT_NR, 1, 2);
+	}
+	if (rc)
+		D_WARN("Failed to create fetch_wait telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_fetch_p50, D_TM_GAUGE, "Fetch queued time p50", "ms",
+			     "sched/fetch_wait_p50/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create fetch_wait_p50 telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_fetch_p99, D_TM_GAUGE, "Fetch queued time p99", "ms",
+			     "sched/fetch_wait_p99/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create fetch_wait_p99 telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+#define SCHED_WAIT_WINDOW	1000	/* msecs */
+
+static inline unsigned int
+wait2bkt(uint64_t msecs)
+{
+	unsigned int	bkt;
+
+	/* Bucket N (N > 0) covers [2^(N-1), 2^N - 1] msecs */
+	bkt = msecs == 0 ? 0 : 64 - __builtin_clzll(msecs);
+	return min(bkt, SCHED_WAIT_BKT_NR - 1);
+}
+
+static inline uint32_t
+bkt2wait(unsigned int bkt)
+{
+	return (1U << bkt) - 1;
+}
+
+static void
+fetch_wait_record(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_stats	*stats = &info->si_stats;
+	uint64_t		 waited;
+
+	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+	waited = info->si_cur_ts - req->sr_enqueue_ts;
+
+	stats->ss_wait_bkts[wait2bkt(waited)]++;
+	d_tm_set_gauge(stats->ss_fetch_wait, waited);
+}
+
+/*
+ * Calculate fetch queued time percentiles on every SCHED_WAIT_WINDOW, the
+ * buckets are halved afterwards so that older samples fade out gradually.
+ */
+static void
+fetch_wait_update(struct sched_info *info)
+{
+	struct sched_stats	*stats = &info->si_stats;
+	uint64_t		 tot = 0, cnt = 0;
+	uint32_t		 p50 = 0, p99 = 0;
+	int			 i;
+
+	if (info->si_cur_ts < stats->ss_wait_ts + SCHED_WAIT_WINDOW)
+		return;
+	stats->ss_wait_ts = info->si_cur_ts;
+
+	for (i = 0; i < SCHED_WAIT_BKT_NR; i++)
+		tot += stats->ss_wait_bkts[i];
+
+	for (i = 0; i < SCHED_WAIT_BKT_NR && tot != 0; i++) {
+		cnt += stats->ss_wait_bkts[i];
+		if (p50 == 0 && cnt * 2 >= tot)
+			p50 = bkt2wait(i);
+		if (cnt * 100 >= tot * 99) {
+			p99 = bkt2wait(i);
+			break;
+		}
+	}
+
+	for (i = 0; i < SCHED_WAIT_BKT_NR; i++)
+		stats->ss_wait_bkts[i] >>= 1;
+
+	stats->ss_fetch_p99_ms = p99;
+	d_tm_set_gauge(stats->ss_fetch_p50, p50);
+	d_tm_set_gauge(stats->ss_fetch_p99, p99);
+}
+
+/* Fetch p99 queued time is beyond the latency target */
+static inline bool
+fetch_slo_missed(struct sched_info *info)
+{
+	return sched_fetch_slo != 0 && info->si_stats.ss_fetch_p99_ms > sched_fetch_slo;
 }
 
 static int
@@ -541,11 +719,19 @@ sched_info_init(struct dss_xstream *dx)
 	D_INIT_LIST_HEAD(&info->si_idle_list);
 	D_INIT_LIST_HEAD(&info->si_sleep_list);
 	D_INIT_LIST_HEAD(&info->si_fifo_list);
+	D_INIT_LIST_HEAD(&info->si_rr_list);
 	D_INIT_LIST_HEAD(&info->si_purge_list);
+	info->si_rr_cnt = 0;
 	info->si_req_cnt = 0;
 	info->si_sleep_cnt = 0;
 	info->si_wait_cnt = 0;
 	info->si_stop = 0;
+	info->si_poll_win_ts = info->si_cur_ts;
+	info->si_poll_busy_ts = 0;
+	info->si_poll_win_cnt = 0;
+	info->si_poll_rate = 0;
+	info->si_poll_intvl = 0;
+	info->si_poll_state = SCHED_POLL_BUSY;
 	sched_metrics_init(dx);
 
 	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 4,
@@ -564,8 +750,9 @@ sched_info_init(struct dss_xstream *dx)
 }
 
 static struct sched_pool_info *
-cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
+cur_pool_info(struct dss_xstream *dx, uuid_t pool_uuid)
 {
+	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_pool_info	*spi;
 	d_list_t		*rlink, *list;
 	unsigned int		 type;
@@ -587,7 +774,11 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&spi->spi_hash_link);
+	D_INIT_LIST_HEAD(&spi->spi_rr_link);
 	uuid_copy(spi->spi_pool_id, pool_uuid);
+	spi->spi_weight = DAOS_SCHED_QOS_WEIGHT(DAOS_PROP_PO_SCHED_QOS_DEFAULT);
+	spi->spi_io_type = SCHED_REQ_UPDATE;
+	spi_metrics_init(dx, spi);
 
 	for (type = SCHED_REQ_UPDATE; type < SCHED_REQ_MAX; type++) {
 		list = pool2req_list(spi, type);
@@ -616,7 +807,7 @@ req_get(struct dss_xstream *dx, struct sched_req_attr *attr,
 	if (attr->sra_type == SCHED_REQ_ANONYM) {
 		spi = NULL;
 	} else {
-		spi = cur_pool_info(info, attr->sra_pool_id);
+		spi = cur_pool_info(dx, attr->sra_pool_id);
 		if (spi == NULL) {
 			D_ERROR("Get pool info "DF_UUID" failed.\n",
 				DP_UUID(attr->sra_pool_id));
@@ -695,6 +886,15 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	D_ASSERT(info->si_req_cnt > 0);
 	info->si_req_cnt--;
 	sw_cycle_update(&spi->spi_stats_window, req->sr_attr.sra_type);
+	if (req->sr_attr.sra_type == SCHED_REQ_FETCH)
+		fetch_wait_record(info, req);
+
+	if (spi->spi_metrics && (req->sr_attr.sra_type == SCHED_REQ_UPDATE ||
+				 req->sr_attr.sra_type == SCHED_REQ_FETCH)) {
+		D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+		d_tm_dec_gauge(spi->spi_queue_depth, 1);
+		d_tm_set_gauge(spi->spi_wait_time, info->si_cur_ts - req->sr_enqueue_ts);
+	}
 
 	d_list_del_init(&req->sr_link);
 	req_put(dx, req);
@@ -796,6 +996,15 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
 		goto kickoff;
 
+	/*
+	 * Latency SLO mode, fetch approaching its deadline is kicked off regardless of
+	 * throttling, and all fetches are kicked off when p99 is already beyond target.
+	 */
+	if (req_type == SCHED_REQ_FETCH && sched_fetch_slo != 0 &&
+	    (fetch_slo_missed(info) ||
+	     info->si_cur_ts + sched_fetch_slo / 4 >= req->sr_deadline))
+		goto kickoff;
+
 	if (req_type == SCHED_REQ_UPDATE) {
 		struct pressure_ratio *pr;
 
@@ -805,6 +1014,14 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 		delay_msecs = max_delay_msecs[req_type];
 	}
 
+	/*
+	 * Don't age out starving background work when fetch latency is beyond target,
+	 * unless the pool is under space pressure or it has been delayed for too long.
+	 */
+	if (req_type >= SCHED_REQ_GC && fetch_slo_missed(info) &&
+	    spi->spi_space_pressure == SCHED_SPACE_PRESS_NONE)
+		delay_msecs = SCHED_DELAY_THRESH;
+
 	/* Request expired */
 	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
 	if ((info->si_cur_ts - req->sr_enqueue_ts) > delay_msecs)
@@ -1095,6 +1312,157 @@ policy_fifo_process(struct dss_xstream *dx)
 	process_req_list(dx, &info->si_fifo_list, false);
 }
 
+/*
+ * Pool RR policy: Deficit round robin across pools with pending IO requests,
+ * each pool earns (weight * SCHED_DRR_QUANTUM) request weights per round, and
+ * the kicked IO requests in one schedule cycle are bounded by SCHED_DRR_BUDGET
+ * when there are multiple active pools.
+ */
+#define SCHED_DRR_QUANTUM	8	/* In request weights */
+#define SCHED_DRR_BUDGET	256	/* In request weights */
+
+static void
+policy_rr_enqueue(struct dss_xstream *dx, struct sched_request *req,
+		  void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi = req->sr_pool_info;
+
+	d_list_add_tail(&req->sr_link, pool2req_list(spi, req->sr_attr.sra_type));
+	if (d_list_empty(&spi->spi_rr_link)) {
+		d_list_add_tail(&spi->spi_rr_link, &info->si_rr_list);
+		info->si_rr_cnt++;
+	}
+}
+
+static inline unsigned int
+rr_other_type(unsigned int type)
+{
+	return type == SCHED_REQ_UPDATE ? SCHED_REQ_FETCH : SCHED_REQ_UPDATE;
+}
+
+/* Token bucket for the pool IOPS limit, allows 100ms burst at most */
+static bool
+spi_iops_throttled(struct sched_info *info, struct sched_pool_info *spi)
+{
+	uint64_t	tokens, burst;
+
+	if (spi->spi_iops_max == 0)
+		return false;
+
+	D_ASSERT(info->si_cur_ts >= spi->spi_iops_ts);
+	tokens = (info->si_cur_ts - spi->spi_iops_ts) * spi->spi_iops_max / 1000;
+	if (tokens != 0) {
+		burst = max(spi->spi_iops_max / 10, 1);
+		spi->spi_iops_tokens = min(spi->spi_iops_tokens + tokens, burst);
+		spi->spi_iops_ts = info->si_cur_ts;
+	}
+
+	return spi->spi_iops_tokens == 0;
+}
+
+/* Return the head request of @type in the pool, or NULL if it's empty or throttled */
+static struct sched_request *
+rr_pool_req(struct sched_info *info, struct sched_pool_info *spi, unsigned int type)
+{
+	struct sched_request	*req;
+	uint64_t		 waited;
+
+	if (d_list_empty(pool2req_list(spi, type)))
+		return NULL;
+
+	req = d_list_entry(pool2req_list(spi, type)->next, struct sched_request, sr_link);
+	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+	waited = info->si_cur_ts - req->sr_enqueue_ts;
+
+	/* Expired or urgent requests are not subject to the IOPS limit */
+	if (!info->si_stop && !(req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY) &&
+	    waited <= max_delay_msecs[type] && spi_iops_throttled(info, spi))
+		return NULL;
+
+	return req;
+}
+
+static unsigned int
+rr_process_pool(struct dss_xstream *dx, struct sched_pool_info *spi, uint64_t *budget)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_request	*req;
+	unsigned int		 type, cost, kicked = 0;
+
+	while (*budget > 0) {
+		/* Alternate UPDATE and FETCH within the pool */
+		type = spi->spi_io_type;
+		req = rr_pool_req(info, spi, type);
+		if (req == NULL) {
+			type = rr_other_type(type);
+			req = rr_pool_req(info, spi, type);
+			if (req == NULL)
+				break;
+		}
+
+		cost = req_weights[type];
+		if (spi->spi_deficit < cost)
+			break;
+
+		/* Space pressure & CPU throttling still applies */
+		if (process_req(dx, req))
+			break;
+
+		spi->spi_deficit -= cost;
+		if (spi->spi_iops_tokens > 0)
+			spi->spi_iops_tokens--;
+		*budget = *budget > cost ? *budget - cost : 0;
+		spi->spi_io_type = rr_other_type(type);
+		kicked++;
+	}
+
+	return kicked;
+}
+
+static void
+policy_rr_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi;
+	uint64_t		 budget, quantum;
+	unsigned int		 i, nr, kicked;
+
+	/* Nothing to be shared when there is only one active pool */
+	budget = (info->si_rr_cnt > 1 && !info->si_stop) ? SCHED_DRR_BUDGET : UINT64_MAX;
+
+	while (budget > 0 && info->si_rr_cnt > 0) {
+		nr = info->si_rr_cnt;
+		kicked = 0;
+
+		for (i = 0; i < nr && budget > 0; i++) {
+			D_ASSERT(!d_list_empty(&info->si_rr_list));
+			spi = d_list_entry(info->si_rr_list.next, struct sched_pool_info,
+					   spi_rr_link);
+
+			quantum = (uint64_t)spi->spi_weight * SCHED_DRR_QUANTUM;
+			spi->spi_deficit += quantum;
+			kicked += rr_process_pool(dx, spi, &budget);
+
+			if (pool2req_cnt(spi, SCHED_REQ_UPDATE) == 0 &&
+			    pool2req_cnt(spi, SCHED_REQ_FETCH) == 0) {
+				d_list_del_init(&spi->spi_rr_link);
+				D_ASSERT(info->si_rr_cnt > 0);
+				info->si_rr_cnt--;
+				spi->spi_deficit = 0;
+				continue;
+			}
+
+			/* Throttled pool doesn't accumulate deficit for bursting */
+			spi->spi_deficit = min(spi->spi_deficit, quantum);
+			d_list_move_tail(&spi->spi_rr_link, &info->si_rr_list);
+		}
+
+		if (kicked == 0)
+			break;
+	}
+}
+
 struct sched_policy_ops {
 	void (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -1107,8 +1475,8 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 		.process_io = policy_fifo_process,
 	},
 	{	/* SCHED_POLICY_ID_RR */
-		.enqueue_io = NULL,
-		.process_io = NULL,
+		.enqueue_io = policy_rr_enqueue,
+		.process_io = policy_rr_process,
 	},
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
@@ -1123,6 +1491,9 @@ process_all(struct dss_xstream *dx)
 	int			 rc;
 
 	prune_purge_list(dx);
+	if (dx->dx_main_xs)
+		fetch_wait_update(info);
+
 	rc = d_hash_table_traverse(info->si_pool_hash, process_pool_cb, dx);
 	if (rc)
 		D_ERROR("Traverse pool hash error. "DF_RC"\n", DP_RC(rc));
@@ -1167,6 +1538,13 @@ req_enqueue(struct dss_xstream *dx, struct sched_request *req)
 		d_list_add_tail(&req->sr_link, &sri->sri_req_list);
 	}
 	req->sr_enqueue_ts = info->si_cur_ts;
+	if (attr->sra_type == SCHED_REQ_FETCH && sched_fetch_slo != 0)
+		req->sr_deadline = req->sr_enqueue_ts + sched_fetch_slo;
+	else
+		req->sr_deadline = req->sr_enqueue_ts + max_delay_msecs[attr->sra_type];
+	if (spi->spi_metrics && (attr->sra_type == SCHED_REQ_UPDATE ||
+				 attr->sra_type == SCHED_REQ_FETCH))
+		d_tm_inc_gauge(spi->spi_queue_depth, 1);
 
 	sri->sri_req_cnt++;
 	spi->spi_req_cnt++;
@@ -1450,6 +1828,36 @@ sched_cond_wait(ABT_cond cond, ABT_mutex mutex)
 	info->si_wait_cnt -= 1;
 }
 
+void
+sched_pool_qos_set(uuid_t pool_uuid, uint64_t qos)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi;
+
+	D_ASSERT(daos_sched_qos_valid(qos));
+	/* Pool info of other xstreams will be created on demand without QoS */
+	if (!dx->dx_main_xs)
+		return;
+
+	spi = cur_pool_info(dx, pool_uuid);
+	if (spi == NULL) {
+		D_ERROR("Get pool info "DF_UUID" failed.\n", DP_UUID(pool_uuid));
+		return;
+	}
+
+	if (spi->spi_weight != DAOS_SCHED_QOS_WEIGHT(qos) ||
+	    spi->spi_iops_max != DAOS_SCHED_QOS_IOPS(qos))
+		D_INFO("Pool "DF_UUID" xs:%d QoS weight:%u iops:%u\n", DP_UUID(pool_uuid),
+		       dx->dx_xs_id, (unsigned int)DAOS_SCHED_QOS_WEIGHT(qos),
+		       (unsigned int)DAOS_SCHED_QOS_IOPS(qos));
+
+	spi->spi_weight = DAOS_SCHED_QOS_WEIGHT(qos);
+	spi->spi_iops_max = DAOS_SCHED_QOS_IOPS(qos);
+	spi->spi_iops_tokens = 0;
+	spi->spi_iops_ts = info->si_cur_ts;
+}
+
 uint64_t
 sched_cur_msec(void)
 {
@@ -1717,6 +2125,62 @@ sched_pop_one(struct sched_data *data, ABT_pool pool, int pool_idx)
 
 #define SCHED_IDLE_THRESH	8000UL	/* msecs */
 
+/*
+ * Thresholds for the adaptive relax mode. The xstream keeps busy polling when
+ * external events arrived in last SCHED_SPIN_THRESH, or when events arrived in
+ * more than SCHED_POLL_RATE cycles of the last SCHED_POLL_WINDOW (smoothed). It
+ * relaxes for sched_relax_intvl when events arrived in last SCHED_WAIT_THRESH,
+ * otherwise, the relaxing interval is doubled on each idle cycle until
+ * SCHED_WAIT_INTVL_MAX.
+ */
+#define SCHED_SPIN_THRESH	2UL	/* msecs */
+#define SCHED_WAIT_THRESH	200UL	/* msecs */
+#define SCHED_POLL_WINDOW	100UL	/* msecs */
+#define SCHED_POLL_RATE		10
+#define SCHED_WAIT_INTVL_MAX	8	/* msecs */
+
+static void
+sched_poll_rate_update(struct sched_info *info)
+{
+	if (info->si_poll_busy_ts != info->si_stats.ss_busy_ts) {
+		info->si_poll_busy_ts = info->si_stats.ss_busy_ts;
+		info->si_poll_win_cnt++;
+	}
+
+	if (info->si_cur_ts < info->si_poll_win_ts + SCHED_POLL_WINDOW)
+		return;
+
+	info->si_poll_rate = (info->si_poll_rate * 3 + info->si_poll_win_cnt) / 4;
+	info->si_poll_win_cnt = 0;
+	info->si_poll_win_ts = info->si_cur_ts;
+}
+
+/* Return the relaxing interval in msecs, 0 means keeping busy polling */
+static unsigned int
+sched_adaptive_intvl(struct sched_info *info)
+{
+	uint64_t	idle = info->si_cur_ts - info->si_stats.ss_busy_ts;
+
+	if (idle < SCHED_SPIN_THRESH || info->si_poll_rate >= SCHED_POLL_RATE) {
+		info->si_poll_intvl = 0;
+		return 0;
+	}
+
+	if (idle < SCHED_WAIT_THRESH) {
+		info->si_poll_state = SCHED_POLL_SPIN;
+		info->si_poll_intvl = 0;
+		return sched_relax_intvl;
+	}
+
+	info->si_poll_state = SCHED_POLL_WAIT;
+	if (info->si_poll_intvl == 0)
+		info->si_poll_intvl = sched_relax_intvl;
+	else
+		info->si_poll_intvl = min(info->si_poll_intvl * 2,
+					  max(SCHED_WAIT_INTVL_MAX, sched_relax_intvl));
+	return info->si_poll_intvl;
+}
+
 /*
  * Try to relax CPU for a short period when the xstream is idle. The relaxing
  * period can't be too long, otherwise, potential external events like:
@@ -1736,10 +2200,14 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	int			 ret;
 
 	dx->dx_timeout = 0;
+	info->si_poll_state = SCHED_POLL_BUSY;
 
 	if (info->si_stop)
 		return;
 
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE)
+		sched_poll_rate_update(info);
+
 	/*
 	 * There are running ULTs in current schedule cycle.
 	 *
@@ -1780,11 +2248,19 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 
 	/*
 	 * System is currently idle, but we only start relaxing when there is
-	 * no external events for a short period of SCHED_IDLE_THRESH.
+	 * no external events for a short period of SCHED_IDLE_THRESH, or when
+	 * the arrival rate is low enough in adaptive mode.
 	 */
 	D_ASSERT(info->si_cur_ts >= info->si_stats.ss_busy_ts);
-	if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH)
+	if (sched_relax_mode == SCHED_RELAX_MODE_ADAPTIVE) {
+		sleep_time = sched_adaptive_intvl(info);
+		if (sleep_time == 0)
+			return;
+	} else if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH) {
 		return;
+	} else {
+		info->si_poll_state = SCHED_POLL_WAIT;
+	}
 
 	/* Adjust sleep time according to the first sleeping ULT */
 	if (info->si_sleep_cnt > 0) {
@@ -1800,6 +2276,9 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 			sleep_time = req->sr_wakeup_time - info->si_cur_ts;
 	}
 	D_ASSERT(sleep_time > 0 && sleep_time <= SCHED_RELAX_INTVL_MAX);
+	/* Restart the backoff from the interval shortened by sleeping ULT */
+	if (info->si_poll_intvl > sleep_time)
+		info->si_poll_intvl = sleep_time;
 
 	/*
 	 * Wait on external network request if the xstream has Cart context,
@@ -1844,6 +2323,8 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 	}
 	duration = cur_ts - info->si_cur_ts;
 	info->si_cur_ts = cur_ts;
+	/* The duration is mostly spent in the polling state of last cycle */
+	d_tm_inc_counter(info->si_stats.ss_poll_time[info->si_poll_state], duration);
 
 	wakeup_all(dx);
 	process_all(dx);
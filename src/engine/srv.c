@@ -88,6 +88,8 @@ unsigned int	dss_sys_xs_nr = DAOS_TGT0_OFFSET + DRPC_XS_NR;
  *         are shared used by all VOS targets.
  */
 bool		dss_helper_pool;
+/** Allow offloaded ULTs to run on a less loaded sibling helper xstream */
+bool		dss_offload_steal = true;
 
 /** Bypass for the nvme health check */
 bool		dss_nvme_bypass_health_check;
@@ -960,6 +962,25 @@ dss_xstreams_init(void)
 	D_INFO("CPU relax mode is set to [%s]\n",
 	       sched_relax_mode2str(sched_relax_mode));
 
+	env = getenv("DAOS_SCHED_POLICY");
+	if (env) {
+		sched_policy = sched_str2policy(env);
+		if (sched_policy == SCHED_POLICY_INVALID) {
+			D_WARN("Invalid IO scheduling policy [%s]\n", env);
+			sched_policy = SCHED_POLICY_FIFO;
+		}
+	}
+	D_INFO("IO scheduling policy is set to [%s]\n",
+	       sched_policy2str(sched_policy));
+
+	d_getenv_bool("DAOS_OFFLOAD_STEAL", &dss_offload_steal);
+	D_INFO("Offloading to sibling helper xstreams is %s\n",
+	       dss_offload_steal ? "enabled" : "disabled");
+
+	d_getenv_int("DAOS_SCHED_FETCH_SLO", &sched_fetch_slo);
+	if (sched_fetch_slo != 0)
+		D_INFO("Fetch latency target is set to %u msecs\n", sched_fetch_slo);
+
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
 
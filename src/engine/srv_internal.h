@@ -7,6 +7,7 @@
 #define __DAOS_SRV_INTERNAL__
 
 #include <daos_srv/daos_engine.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_common.h>
 
 /**
@@ -24,6 +25,17 @@ enum {
 	DSS_POOL_CNT,
 };
 
+/* Polling state of xstream, see sched_try_relax() */
+enum sched_poll_state {
+	SCHED_POLL_BUSY		= 0,	/* Busy polling */
+	SCHED_POLL_SPIN,		/* Relax for a short interval */
+	SCHED_POLL_WAIT,		/* Event driven wait with backoff interval */
+	SCHED_POLL_STATE_MAX,
+};
+
+/* Log2 buckets of fetch queued time, the last one is for >= 1024 msecs */
+#define SCHED_WAIT_BKT_NR	12
+
 struct sched_stats {
 	struct d_tm_node_t	*ss_total_time;		/* Total CPU time (ms) */
 	struct d_tm_node_t	*ss_relax_time;		/* CPU relax time (ms) */
@@ -31,6 +43,13 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_sq_len;		/* Sleep queue length */
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
+	struct d_tm_node_t	*ss_poll_time[SCHED_POLL_STATE_MAX]; /* Time in state (ms) */
+	struct d_tm_node_t	*ss_fetch_wait;		/* Fetch queued time (ms) */
+	struct d_tm_node_t	*ss_fetch_p50;		/* Fetch queued time p50 (ms) */
+	struct d_tm_node_t	*ss_fetch_p99;		/* Fetch queued time p99 (ms) */
+	uint32_t		 ss_wait_bkts[SCHED_WAIT_BKT_NR]; /* Fetch queued time */
+	uint64_t		 ss_wait_ts;		/* Last percentile update ts (ms) */
+	uint32_t		 ss_fetch_p99_ms;	/* Fetch queued time p99 (ms) */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -45,11 +64,19 @@ struct sched_info {
 	d_list_t		 si_idle_list;	/* All unused requests */
 	d_list_t		 si_sleep_list;	/* All sleeping requests */
 	d_list_t		 si_fifo_list;	/* All IO requests in FIFO */
+	d_list_t		 si_rr_list;	/* Pools with pending IO, for pool RR */
+	uint32_t		 si_rr_cnt;	/* Pool count in si_rr_list */
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
 	int			 si_sleep_cnt;	/* Sleeping request count */
 	int			 si_wait_cnt;	/* Long wait request count */
+	uint64_t		 si_poll_win_ts; /* Start of arrival window (ms) */
+	uint64_t		 si_poll_busy_ts; /* Busy ts seen on last cycle (ms) */
+	uint32_t		 si_poll_win_cnt; /* Cycles with arrivals in window */
+	uint32_t		 si_poll_rate;	/* Smoothed si_poll_win_cnt */
+	uint32_t		 si_poll_intvl;	/* Current wait interval (ms) */
+	unsigned int		 si_poll_state;	/* Polling state of last cycle */
 	unsigned int		 si_stop:1;
 };
 
@@ -80,6 +107,8 @@ struct dss_xstream {
 	bool			dx_comm;	/* true with cart context */
 	bool			dx_dsc_started;	/* DSC progress ULT started */
 	bool			dx_progress_started;	/* Network poll started */
+	/* Offloaded ULTs submitted by dss_offload_submit() and not done yet */
+	ATOMIC uint32_t		dx_offload_inflight;
 };
 
 /** Engine module's metrics */
@@ -119,6 +148,7 @@ extern unsigned int	dss_tgt_offload_xs_nr;
 extern unsigned int	dss_sys_xs_nr;
 /** Flag of helper XS as a pool */
 extern bool		dss_helper_pool;
+extern bool		dss_offload_steal;
 
 /** Shadow dss_get_module_info */
 struct dss_module_info *get_module_info(void);
@@ -158,6 +188,7 @@ enum sched_cpu_relax_mode {
 	SCHED_RELAX_MODE_NET		= 0,
 	SCHED_RELAX_MODE_SLEEP,
 	SCHED_RELAX_MODE_DISABLED,
+	SCHED_RELAX_MODE_ADAPTIVE,
 	SCHED_RELAX_MODE_INVALID,
 };
 
@@ -171,6 +202,8 @@ sched_relax_mode2str(enum sched_cpu_relax_mode mode)
 		return "sleep";
 	case SCHED_RELAX_MODE_DISABLED:
 		return "disabled";
+	case SCHED_RELAX_MODE_ADAPTIVE:
+		return "adaptive";
 	default:
 		return "invalid";
 	}
@@ -185,11 +218,56 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_NET;
 	else if (strcasecmp(str, "disabled") == 0)
 		return SCHED_RELAX_MODE_DISABLED;
+	else if (strcasecmp(str, "adaptive") == 0)
+		return SCHED_RELAX_MODE_ADAPTIVE;
 	else
 		return SCHED_RELAX_MODE_INVALID;
 }
 
+enum sched_policy_id {
+	/* All requests for various pools are processed in FIFO */
+	SCHED_POLICY_FIFO	= 0,
+	/*
+	 * All requests are processed in RR based on certain ID (Client ID,
+	 * Pool ID, Container ID, JobID, UID, etc.), only pool ID for now.
+	 */
+	SCHED_POLICY_ID_RR,
+	/*
+	 * Request priority is based on certain ID (Client ID, Pool ID,
+	 * Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_PRIO,
+	SCHED_POLICY_MAX,
+	SCHED_POLICY_INVALID	= SCHED_POLICY_MAX,
+};
+
+static inline char *
+sched_policy2str(enum sched_policy_id policy)
+{
+	switch (policy) {
+	case SCHED_POLICY_FIFO:
+		return "fifo";
+	case SCHED_POLICY_ID_RR:
+		return "pool_rr";
+	default:
+		return "invalid";
+	}
+}
+
+static inline enum sched_policy_id
+sched_str2policy(char *str)
+{
+	if (strcasecmp(str, "fifo") == 0)
+		return SCHED_POLICY_FIFO;
+	else if (strcasecmp(str, "pool_rr") == 0)
+		return SCHED_POLICY_ID_RR;
+	else
+		return SCHED_POLICY_INVALID;
+}
+
 extern bool sched_prio_disabled;
+extern unsigned int sched_policy;
+extern unsigned int sched_fetch_slo;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
@@ -579,13 +579,129 @@ dss_ult_create_all(void (*func)(void *), void *arg, bool main)
 	return rc;
 }
 
+/* ============== Offload functions ====================================== */
+
+struct offload_arg {
+	void			(*oa_func)(void *);
+	void			*oa_arg;
+	struct dss_xstream	*oa_dx;
+};
+
+/*
+ * Pick the offload xstream for \a tgt_id. The helper xstream dedicated to the
+ * target is compared against a randomly picked sibling helper xstream, and the
+ * one with less pending offloaded ULTs wins.
+ */
+static int
+offload_xs_select(int tgt_id)
+{
+	struct dss_xstream	*home, *peer;
+	int			 home_id, peer_id, per_tgt, idx;
+
+	home_id = sched_ult2xs(DSS_XS_OFFLOAD, tgt_id);
+	if (!dss_offload_steal || dss_tgt_offload_xs_nr < 2)
+		return home_id;
+
+	idx = d_rand() % dss_tgt_offload_xs_nr;
+	if (dss_helper_pool) {
+		peer_id = dss_sys_xs_nr + dss_tgt_nr + idx;
+	} else {
+		per_tgt = dss_tgt_offload_xs_nr / dss_tgt_nr;
+		peer_id = DSS_MAIN_XS_ID(idx / per_tgt) + 1 + idx % per_tgt;
+	}
+	if (peer_id == home_id)
+		return home_id;
+
+	home = dss_get_xstream(home_id);
+	peer = dss_get_xstream(peer_id);
+	if (home == NULL || peer == NULL)
+		return home_id;
+
+	if (atomic_load_relaxed(&peer->dx_offload_inflight) <
+	    atomic_load_relaxed(&home->dx_offload_inflight))
+		return peer_id;
+
+	return home_id;
+}
+
+static void
+offload_ult(void *data)
+{
+	struct offload_arg	*oa = data;
+	struct dss_xstream	*dx = oa->oa_dx;
+
+	oa->oa_func(oa->oa_arg);
+	atomic_fetch_sub(&dx->dx_offload_inflight, 1);
+	D_FREE(oa);
+}
+
+/**
+ * Create a ULT to execute \a func(\a arg) on a helper xstream, the helper
+ * xstream of the current target is used unless a sibling helper xstream is
+ * less loaded. Only CPU intensive and target agnostic work (checksum, EC
+ * encoding, etc.) should be offloaded, since \a func could be executed on
+ * behalf of any target. The caller is responsible for waiting the completion.
+ *
+ * \param[in]	func	function to execute
+ * \param[in]	arg	argument for \a func
+ *
+ * \return		Zero on success, negative value on error.
+ */
+int
+dss_offload_submit(void (*func)(void *), void *arg)
+{
+	struct dss_module_info	*info = dss_get_module_info();
+	struct offload_arg	*oa;
+	struct dss_xstream	*dx;
+	int			 rc;
+
+	D_ASSERT(info != NULL);
+	D_ASSERT(info->dmi_tgt_id >= 0);
+
+	dx = dss_get_xstream(offload_xs_select(info->dmi_tgt_id));
+	if (dx == NULL)
+		return -DER_NONEXIST;
+
+	D_ALLOC_PTR(oa);
+	if (oa == NULL)
+		return -DER_NOMEM;
+
+	oa->oa_func = func;
+	oa->oa_arg = arg;
+	oa->oa_dx = dx;
+
+	atomic_fetch_add(&dx->dx_offload_inflight, 1);
+	rc = sched_create_thread(dx, offload_ult, oa, ABT_THREAD_ATTR_NULL, NULL, 0);
+	if (rc) {
+		atomic_fetch_sub(&dx->dx_offload_inflight, 1);
+		D_FREE(oa);
+	}
+
+	return rc;
+}
+
 int
 dss_offload_exec(int (*func)(void *), void *arg)
 {
-	struct dss_module_info *info = dss_get_module_info();
+	struct dss_module_info	*info = dss_get_module_info();
+	struct dss_future_arg	 future_arg = { 0 };
+	int			 rc;
 
 	D_ASSERT(info != NULL);
 	D_ASSERT(info->dmi_xstream->dx_main_xs);
 
-	return dss_ult_execute(func, arg, NULL, NULL, DSS_XS_OFFLOAD, info->dmi_tgt_id, 0);
+	rc = ABT_future_create(1, NULL, &future_arg.dfa_future);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+	future_arg.dfa_func = func;
+	future_arg.dfa_arg = arg;
+
+	rc = dss_offload_submit(ult_execute_cb, &future_arg);
+	if (rc == 0) {
+		ABT_future_wait(future_arg.dfa_future);
+		rc = future_arg.dfa_status;
+	}
+	ABT_future_free(&future_arg.dfa_future);
+
+	return rc;
 }
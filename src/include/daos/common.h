@@ -204,6 +204,15 @@ clrbit_range(uint8_t *bitmap, uint32_t start, uint32_t end)
 		clrbit(bitmap, index);
 }
 
+static inline void
+setbit_range(uint8_t *bitmap, uint32_t start, uint32_t end)
+{
+	uint32_t index;
+
+	for (index = start; index <= end; ++index)
+		setbit(bitmap, index);
+}
+
 static inline unsigned int
 daos_power2_nbits(unsigned int val)
 {
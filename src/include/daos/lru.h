@@ -63,21 +63,30 @@ struct daos_llink_ops {
 
 struct daos_llink {
 	d_list_t		 ll_link;	/**< LRU hash link */
-	d_list_t		 ll_qlink;	/**< Temp link for traverse */
+	d_list_t		 ll_qlink;	/**< Link to the CLOCK ring */
 	uint32_t		 ll_ref;	/**< refcount for this ref */
-	uint32_t		 ll_evicted:1;	/**< has been evicted */
+	uint32_t		 ll_evicted:1,	/**< has been evicted */
+				 ll_accessed:1;	/**< referenced since last sweep */
+	uint32_t		 ll_hint;	/**< hint slot + 1, 0 for none */
 	struct daos_llink_ops	*ll_ops;	/**< ops to maintain refs */
 };
 
+/** Number of direct-mapped slots for recently held items */
+#define DAOS_LRU_HINT_NR	64
+
 /**
- * LRU cache implementation using d_hash_table and d_list_t
+ * LRU cache implementation using d_hash_table and d_list_t, the LRU is
+ * approximated by CLOCK (second chance), so holding a cached item doesn't
+ * need to relink it. Recently held items are remembered in a small direct
+ * mapped array, repeated holds on them don't need a hash lookup.
  */
 struct daos_lru_cache {
 	uint32_t		 dlc_csize;	/**< Provided cache size */
 	uint32_t		 dlc_count;	/**< count of refs in cache */
-	d_list_t		 dlc_lru;	/**< list head of LRU */
+	d_list_t		 dlc_lru;	/**< CLOCK ring of all refs */
 	struct d_hash_table	 dlc_htable;	/**< Hash table for all refs */
 	struct daos_llink_ops	*dlc_ops;	/**< ops to maintain refs */
+	struct daos_llink	*dlc_hint[DAOS_LRU_HINT_NR]; /**< recent refs */
 };
 
 /**
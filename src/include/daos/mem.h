@@ -225,11 +225,12 @@ typedef struct {
 	 * \param umm	[IN]		umem class instance.
 	 * \param act	[IN|OUT]	action used for later cancel/publish.
 	 * \param size	[IN]		size to be reserved.
+	 * \param flags	[IN]		reserve flags, e.g. slab class
 	 * \param type_num [IN]		struct type (for PMDK)
 	 */
 	umem_off_t	 (*mo_reserve)(struct umem_instance *umm,
 				       struct pobj_action *act, size_t size,
-				       unsigned int type_num);
+				       uint64_t flags, unsigned int type_num);
 
 	/**
 	 * Defer free til commit.  For use with reserved extents that are not
@@ -283,7 +284,7 @@ typedef struct {
 } umem_ops_t;
 
 
-#define UMM_SLABS_CNT	7
+#define UMM_SLABS_CNT	14
 
 /** attributes to initialize an unified memory class */
 struct umem_attr {
@@ -297,6 +298,19 @@ struct umem_attr {
 #endif
 };
 
+#ifdef DAOS_PMEM_BUILD
+/**
+ * Slab of the umem pool cached by umem instance, it is a compact copy of
+ * pobj_alloc_class_desc because umem instance is embedded in many contexts.
+ */
+struct umem_slab_desc {
+	/** unit size of the slab */
+	uint32_t		 usd_unit_size;
+	/** PMDK allocation class ID, zero if the slab is not registered */
+	uint32_t		 usd_class_id;
+};
+#endif
+
 /** instance of an unified memory class */
 struct umem_instance {
 	umem_class_id_t		 umm_id;
@@ -315,7 +329,7 @@ struct umem_instance {
 	umem_ops_t		*umm_ops;
 #ifdef DAOS_PMEM_BUILD
 	/** Slabs of the umem pool */
-	struct pobj_alloc_class_desc	 umm_slabs[UMM_SLABS_CNT];
+	struct umem_slab_desc	 umm_slabs[UMM_SLABS_CNT];
 #endif
 };
 
@@ -324,27 +338,54 @@ static inline bool
 umem_slab_registered(struct umem_instance *umm, unsigned int slab_id)
 {
 	D_ASSERT(slab_id < UMM_SLABS_CNT);
-	return umm->umm_slabs[slab_id].class_id != 0;
+	return umm->umm_slabs[slab_id].usd_class_id != 0;
 }
 
 static inline uint64_t
 umem_slab_flags(struct umem_instance *umm, unsigned int slab_id)
 {
 	D_ASSERT(slab_id < UMM_SLABS_CNT);
-	return POBJ_CLASS_ID(umm->umm_slabs[slab_id].class_id);
+	return POBJ_CLASS_ID(umm->umm_slabs[slab_id].usd_class_id);
 }
 
 static inline size_t
 umem_slab_usize(struct umem_instance *umm, unsigned int slab_id)
 {
 	D_ASSERT(slab_id < UMM_SLABS_CNT);
-	return umm->umm_slabs[slab_id].unit_size;
+	return umm->umm_slabs[slab_id].usd_unit_size;
 }
 #endif
 
 int  umem_class_init(struct umem_attr *uma, struct umem_instance *umm);
 void umem_attr_get(struct umem_instance *umm, struct umem_attr *uma);
 
+/**
+ * Per-thread DRAM cache for persistent memory blocks which are read often but
+ * rarely modified, e.g. intermediate nodes of btree and evtree.
+ *
+ * A cached copy is never used within a transaction, and all cached copies of
+ * the thread are dropped when a transaction which modified persistent memory
+ * ends on the thread. So the copy always has the same content as the block.
+ *
+ * \param nr	[IN]	Number of cache slots, rounded up to power of 2,
+ *			zero disables the cache for the thread.
+ */
+int  umem_node_cache_init(unsigned int nr);
+/** Free the node cache of the current thread */
+void umem_node_cache_fini(void);
+
+/**
+ * Return a read-only copy of the memory block at \a umoff, the returned copy
+ * is only valid until the next call of this function or yield. It returns the
+ * direct address of the block if the cache is disabled or not applicable.
+ *
+ * \param umm	[IN]	umem pool instance
+ * \param umoff	[IN]	offset of the block
+ * \param size	[IN]	size of the block
+ */
+void *umem_node_cache_read(struct umem_instance *umm, umem_off_t umoff,
+			   size_t size);
+
 /** Convert an offset to pointer.
  *
  *  \param	umm[IN]		The umem pool instance
@@ -521,14 +562,21 @@ umem_tx_end(struct umem_instance *umm, int err)
 
 #ifdef DAOS_PMEM_BUILD
 static inline umem_off_t
-umem_reserve(struct umem_instance *umm, struct pobj_action *act, size_t size)
+umem_reserve_verb(struct umem_instance *umm, struct pobj_action *act,
+		  uint64_t flags, size_t size)
 {
 	if (umm->umm_ops->mo_reserve)
-		return umm->umm_ops->mo_reserve(umm, act, size,
+		return umm->umm_ops->mo_reserve(umm, act, size, flags,
 						UMEM_TYPE_ANY);
 	return UMOFF_NULL;
 }
 
+static inline umem_off_t
+umem_reserve(struct umem_instance *umm, struct pobj_action *act, size_t size)
+{
+	return umem_reserve_verb(umm, act, 0, size);
+}
+
 static inline void
 umem_defer_free(struct umem_instance *umm, umem_off_t off,
 		struct pobj_action *act)
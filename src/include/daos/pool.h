@@ -41,7 +41,8 @@
 #define DAOS_PO_QUERY_PROP_POLICY	(1ULL << (PROP_BIT_START + 12))
 #define DAOS_PO_QUERY_PROP_GLOBAL_VERSION (1ULL << (PROP_BIT_START + 13))
 #define DAOS_PO_QUERY_PROP_UPGRADE_STATUS (1ULL << (PROP_BIT_START + 14))
-#define DAOS_PO_QUERY_PROP_BIT_END	30
+#define DAOS_PO_QUERY_PROP_SCHED_QOS	(1ULL << (PROP_BIT_START + 15))
+#define DAOS_PO_QUERY_PROP_BIT_END	31
 
 #define DAOS_PO_QUERY_PROP_ALL						\
 	(DAOS_PO_QUERY_PROP_LABEL | DAOS_PO_QUERY_PROP_SPACE_RB |	\
@@ -51,7 +52,7 @@
 	 DAOS_PO_QUERY_PROP_EC_CELL_SZ | DAOS_PO_QUERY_PROP_EC_PDA | \
 	 DAOS_PO_QUERY_PROP_RP_PDA | DAOS_PO_QUERY_PROP_REDUN_FAC | \
 	 DAOS_PO_QUERY_PROP_POLICY | DAOS_PO_QUERY_PROP_GLOBAL_VERSION | \
-	 DAOS_PO_QUERY_PROP_UPGRADE_STATUS)
+	 DAOS_PO_QUERY_PROP_UPGRADE_STATUS | DAOS_PO_QUERY_PROP_SCHED_QOS)
 
 
 int dc_pool_init(void);
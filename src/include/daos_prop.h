@@ -98,6 +98,10 @@ enum daos_pool_props {
 	 * Pool upgrade status.
 	 */
 	DAOS_PROP_PO_UPGRADE_STATUS,
+	/**
+	 * I/O scheduling QoS of the pool, see DAOS_SCHED_QOS().
+	 */
+	DAOS_PROP_PO_SCHED_QOS,
 	DAOS_PROP_PO_MAX,
 };
 
@@ -126,6 +130,23 @@ daos_rf_is_valid(unsigned long long rf)
  */
 #define DAOS_PROP_PO_EC_PDA_DEFAULT	1
 
+/**
+ * Pool I/O scheduling QoS is packed in one value: the lower 16 bits is the
+ * weight of the pool (1 ~ 65535) on sharing the target with other pools, the
+ * next 32 bits is the max IOPS of the pool on each target (0 means no limit).
+ */
+#define DAOS_SCHED_QOS(weight, iops)	\
+	(((uint64_t)(iops) << 16) | ((uint64_t)(weight) & 0xffff))
+#define DAOS_SCHED_QOS_WEIGHT(qos)	((uint32_t)((qos) & 0xffff))
+#define DAOS_SCHED_QOS_IOPS(qos)	((uint32_t)(((qos) >> 16) & 0xffffffff))
+#define DAOS_PROP_PO_SCHED_QOS_DEFAULT	DAOS_SCHED_QOS(1, 0)
+
+static inline bool
+daos_sched_qos_valid(uint64_t qos)
+{
+	return DAOS_SCHED_QOS_WEIGHT(qos) != 0 && (qos >> 48) == 0;
+}
+
 /** DAOS pool upgrade status */
 enum {
 	DAOS_UPGRADE_STATUS_NOT_STARTED = 0,
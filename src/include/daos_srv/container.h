@@ -97,6 +97,10 @@ struct ds_cont_child {
 	uint32_t		 sc_open;
 
 	uint64_t		 sc_dtx_committable_count;
+	/* Total DTX entries ever added into the CoS cache, for prepare rate sampling. */
+	uint64_t		 sc_dtx_cos_added;
+	/* Total DTX_REFRESH hits on non-committed DTXs for which current target is leader. */
+	uint64_t		 sc_dtx_refresh_hits;
 
 	/* The global minimum EC aggregation epoch, which will be upper
 	 * limit for VOS aggregation, i.e. EC object VOS aggregation can
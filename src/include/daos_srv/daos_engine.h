@@ -337,6 +337,15 @@ int sched_req_space_check(struct sched_request *req);
  */
 void sched_cond_wait(ABT_cond cond, ABT_mutex mutex);
 
+/**
+ * Set the IO scheduling QoS of a pool on current xstream, it only takes
+ * effect when the "pool_rr" scheduling policy is enabled.
+ *
+ * \param[in] pool_uuid	Pool UUID.
+ * \param[in] qos	QoS packed by DAOS_SCHED_QOS().
+ */
+void sched_pool_qos_set(uuid_t pool_uuid, uint64_t qos);
+
 /**
  * Get current monotonic time in milli-seconds.
  */
@@ -513,6 +522,7 @@ int dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
 		    void *cb_args, int xs_type, int tgt_id, size_t stack_size);
 int dss_ult_create_all(void (*func)(void *), void *arg, bool main);
 int __attribute__((weak)) dss_offload_exec(int (*func)(void *), void *arg);
+int dss_offload_submit(void (*func)(void *), void *arg);
 
 /*
  * If server wants to create ULTs periodically, it should call this special
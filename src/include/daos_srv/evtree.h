@@ -282,10 +282,19 @@ enum evt_feats {
 	 *  evenly
 	 */
 	EVT_FEAT_SORT_DIST_EVEN		= (1 << 2),
+	/** Intermediate nodes store a copy of the MBRs of their children as
+	 *  arrays next to the child offsets, so searching a node doesn't
+	 *  have to load any child node.
+	 */
+	EVT_FEAT_CHILD_MBR		= (1 << 3),
 	/** Place new feats above this line */
 	EVT_FEATS_END,
 	/** Calculated mask for all supported feats */
 	EVT_FEATS_SUPPORTED		= ((EVT_FEATS_END - 1) << 1) - 1,
+	/** Mask of the sort policy feats, only one of them can be set */
+	EVT_FEATS_POLICY		= (EVT_FEAT_SORT_SOFF |
+					   EVT_FEAT_SORT_DIST |
+					   EVT_FEAT_SORT_DIST_EVEN),
 };
 
 /** These are "internal" flags meant to match the btree ones */
@@ -595,6 +604,25 @@ int evt_drain(daos_handle_t toh, int *credits, bool *destroyed);
 int evt_insert(daos_handle_t toh, const struct evt_entry_in *entry,
 	       uint8_t **csum_bufp);
 
+/**
+ * Load entries into an empty tree. Entries can be in any order, they are
+ * sorted by rectangle, packed into leaves and then the tree is built from
+ * bottom to top in one transaction. It is much cheaper than inserting them
+ * one by one, e.g. for rebuilding or copying an object.
+ *
+ * Entries with the same epoch must not overlap.
+ *
+ * \param toh		[IN]	The tree open handle
+ * \param nr		[IN]	Number of entries
+ * \param entries	[IN]	The entries to load
+ *
+ * \return	0 success
+ *		-DER_INVAL the tree is not empty, or duplicate entries
+ *		< 0 on other error
+ */
+int evt_bulk_load(daos_handle_t toh, unsigned int nr,
+		  const struct evt_entry_in *entries);
+
 /**
  * Delete an extent \a rect from an opened tree.
  *
@@ -774,12 +802,14 @@ int evt_iter_fetch(daos_handle_t ih, unsigned int *inob,
 /** Get overhead constants for an evtree
  *
  * \param alloc_overhead[IN]	Expected per-allocation overhead in bytes
+ * \param feats[IN]		The tree features used in creation, see
+ *				\a evt_feats
  * \param tree_order[IN]	The expected tree order used in creation
  * \param ovhd[OUT]		Struct to fill with overheads
  *
  * \return 0 on success, error otherwise
  */
-int evt_overhead_get(int alloc_overhead, int tree_order,
+int evt_overhead_get(int alloc_overhead, uint64_t feats, int tree_order,
 		     struct daos_tree_overhead *ovhd);
 
 /** Get the tree feats
@@ -118,6 +118,7 @@ struct vea_stat {
 	uint64_t	vs_frags_large;	/* Large free frags */
 	uint64_t	vs_frags_small;	/* Small free frags */
 	uint64_t	vs_frags_aging;	/* Aging frags */
+	uint64_t	vs_largest_blks; /* Blocks of the largest free extent */
 };
 
 struct vea_space_info;
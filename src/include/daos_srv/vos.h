@@ -144,6 +144,20 @@ vos_dtx_set_flags(daos_handle_t coh, struct dtx_id *dti, uint32_t flags);
 int
 vos_dtx_aggregate(daos_handle_t coh);
 
+/**
+ * Enlarge the bloom filter for the committed DTX table if it becomes too dense.
+ * Each call re-adds a bounded batch of committed DTXs into the new filter, the
+ * caller should yield between calls until the rebuild is done.
+ *
+ * \param coh	[IN]	Container open handle.
+ *
+ * \return		Zero if nothing to do or the rebuild is done,
+ *			positive value if the rebuild is in progress,
+ *			negative value if error.
+ */
+int
+vos_dtx_cmt_bloom_grow(daos_handle_t coh);
+
 /**
  * Query the container's DTXs statistics information.
  *
@@ -1105,7 +1119,8 @@ vos_obj_query_key(daos_handle_t coh, daos_unit_oid_t oid, uint32_t flags,
  *
  *  \param alloc_overhead[IN]	Expected allocation overhead
  *  \param tclass[IN]		The type of tree to query
- *  \param otype[IN]		Relevant object features
+ *  \param otype[IN]		Relevant object features, or evtree
+ *				features for VOS_TC_ARRAY
  *  \param ovhd[IN,OUT]		Returned overheads
  *
  *  \return 0 on success, error otherwise.
@@ -674,17 +674,15 @@ agg_encode_full_stripe(struct ec_agg_entry *entry)
 {
 	struct ec_agg_stripe_ud		stripe_ud = { 0 };
 	int				*status;
-	int				tid, rc = 0;
+	int				rc = 0;
 
 	stripe_ud.asu_agg_entry = entry;
-	tid = dss_get_module_info()->dmi_tgt_id;
 	rc = ABT_eventual_create(sizeof(*status), &stripe_ud.asu_eventual);
 	if (rc != ABT_SUCCESS) {
 		rc = dss_abterr2der(rc);
 		goto out;
 	}
-	rc = dss_ult_create(agg_encode_full_stripe_ult, &stripe_ud,
-			    DSS_XS_OFFLOAD, tid, 0, NULL);
+	rc = dss_offload_submit(agg_encode_full_stripe_ult, &stripe_ud);
 	if (rc)
 		goto ev_out;
 
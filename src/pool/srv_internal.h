@@ -60,6 +60,7 @@ struct pool_iv_prop {
 	uint64_t	pip_self_heal;
 	uint64_t	pip_reclaim;
 	uint64_t	pip_ec_cell_sz;
+	uint64_t	pip_sched_qos;
 	uint32_t	pip_redun_fac;
 	uint32_t	pip_ec_pda;
 	uint32_t	pip_rp_pda;
@@ -38,6 +38,7 @@ RDB_STRING_KEY(ds_pool_prop_, ec_cell_sz);
 RDB_STRING_KEY(ds_pool_prop_, redun_fac);
 RDB_STRING_KEY(ds_pool_prop_, ec_pda);
 RDB_STRING_KEY(ds_pool_prop_, rp_pda);
+RDB_STRING_KEY(ds_pool_prop_, sched_qos);
 RDB_STRING_KEY(ds_pool_attr_, user);
 
 /** default properties, should cover all optional pool properties */
@@ -89,6 +90,9 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_PO_UPGRADE_STATUS,
 		.dpe_val	= DAOS_UPGRADE_STATUS_NOT_STARTED,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_SCHED_QOS,
+		.dpe_val	= DAOS_PROP_PO_SCHED_QOS_DEFAULT,
 	}
 };
 
@@ -63,6 +63,7 @@ extern d_iov_t ds_pool_prop_ec_cell_sz;		/* uint64_t */
 extern d_iov_t ds_pool_prop_redun_fac;		/* uint64_t */
 extern d_iov_t ds_pool_prop_ec_pda;		/* uint32_t */
 extern d_iov_t ds_pool_prop_rp_pda;		/* uint32_t */
+extern d_iov_t ds_pool_prop_sched_qos;		/* uint64_t */
 extern d_iov_t ds_pool_attr_user;		/* pool user attributes KVS */
 extern d_iov_t ds_pool_prop_policy;		/* string (tiering policy) */
 extern d_iov_t ds_pool_prop_global_version;	/* uint32_t */
@@ -389,6 +389,7 @@ pool_alloc_ref(void *key, unsigned int ksize, void *varg,
 	uuid_copy(pool->sp_uuid, key);
 	pool->sp_map_version = arg->pca_map_version;
 	pool->sp_reclaim = DAOS_RECLAIM_LAZY; /* default reclaim strategy */
+	pool->sp_sched_qos = DAOS_PROP_PO_SCHED_QOS_DEFAULT;
 	pool->sp_policy_desc.policy =
 			DAOS_MEDIA_POLICY_IO_SIZE; /* default tiering policy */
 
@@ -1474,6 +1475,8 @@ update_vos_prop_on_targets(void *in)
 	int				ret = 0;
 	uint64_t			features = 0;
 
+	sched_pool_qos_set(pool->sp_uuid, pool->sp_sched_qos);
+
 	child = ds_pool_child_lookup(pool->sp_uuid);
 	if (child == NULL)
 		return -DER_NONEXIST;	/* no child created yet? */
@@ -1501,6 +1504,7 @@ ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
 	pool->sp_redun_fac = iv_prop->pip_redun_fac;
 	pool->sp_ec_pda = iv_prop->pip_ec_pda;
 	pool->sp_rp_pda = iv_prop->pip_rp_pda;
+	pool->sp_sched_qos = iv_prop->pip_sched_qos;
 
 	if (!daos_policy_try_parse(iv_prop->pip_policy_str,
 				   &pool->sp_policy_desc)) {
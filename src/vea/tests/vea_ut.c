@@ -593,6 +593,173 @@ ut_reserve_special(void **state)
 	ut_teardown(&args);
 }
 
+static void
+ut_magazine(void **state)
+{
+	struct vea_ut_args	 args;
+	struct vea_unmap_context unmap_ctxt;
+	struct vea_resrvd_ext	*ext;
+	struct vea_stat		 stat;
+	d_list_t		*r_list;
+	uint64_t		 off_a, off_b;
+	uint32_t		 blk_cnt = 4, tot_blks;
+	int			 rc;
+
+	ut_setup(&args);
+
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 0, 1,
+			UT_TOTAL_BLKS, NULL, NULL, false);
+	assert_rc_equal(rc, 0);
+
+	setenv("DAOS_VEA_MAG_DEPTH", "8", 1);
+	unmap_ctxt.vnc_unmap = NULL;
+	unmap_ctxt.vnc_data = NULL;
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	unsetenv("DAOS_VEA_MAG_DEPTH");
+	assert_rc_equal(rc, 0);
+	assert_ptr_not_equal(args.vua_vsi->vsi_mags, NULL);
+
+	print_message("reserve two extents from magazine\n");
+	r_list = &args.vua_resrvd_list[0];
+	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_a = ext->vre_blk_off;
+
+	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_b = ext->vre_blk_off;
+
+	/* Extents popped from a refilled magazine are contiguous */
+	assert_int_equal(off_b, off_a + blk_cnt);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_a, blk_cnt * 2);
+	assert_rc_equal(rc, 0);
+
+	print_message("cancel reservation to magazine\n");
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_a, blk_cnt);
+	assert_rc_equal(rc, 1);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b, blk_cnt);
+	assert_rc_equal(rc, 1);
+
+	/* The canceled extent is reused by next reserve */
+	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	assert_int_equal(ext->vre_blk_off, off_b);
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+
+	/* Cached extents are accounted as free, and drained on force flush */
+	tot_blks = UT_TOTAL_BLKS / (1 << 12) - 1;
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_free_transient, tot_blks);
+
+	vea_flush(args.vua_vsi, true);
+	assert_int_equal(magazine_free_blks(args.vua_vsi), 0);
+	assert_int_equal(args.vua_vsi->vsi_stat[STAT_FREE_BLKS], tot_blks);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
+static void
+ut_bitmap(void **state)
+{
+	struct vea_ut_args	 args;
+	struct vea_unmap_context unmap_ctxt;
+	struct vea_resrvd_ext	*ext;
+	struct vea_stat		 stat;
+	d_list_t		*r_list;
+	uint64_t		 off_a, off_b, blk_off;
+	uint32_t		 tot_blks;
+	int			 rc;
+
+	ut_setup(&args);
+
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 0, 1,
+			UT_TOTAL_BLKS, NULL, NULL, false);
+	assert_rc_equal(rc, 0);
+
+	setenv("DAOS_VEA_BITMAP", "1", 1);
+	unmap_ctxt.vnc_unmap = NULL;
+	unmap_ctxt.vnc_data = NULL;
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	unsetenv("DAOS_VEA_BITMAP");
+	assert_rc_equal(rc, 0);
+
+	print_message("reserve small extents from bitmap chunk\n");
+	r_list = &args.vua_resrvd_list[0];
+	rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_a = ext->vre_blk_off;
+
+	rc = vea_reserve(args.vua_vsi, 8, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_b = ext->vre_blk_off;
+
+	/* Both are packed in the same chunk */
+	assert_int_equal(off_b, off_a + 1);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_a, 9);
+	assert_rc_equal(rc, 0);
+	/* The rest of the chunk is still free */
+	rc = vea_verify_alloc(args.vua_vsi, true, off_a + 9, VEA_BITMAP_CHUNK_BLKS - 9);
+	assert_rc_equal(rc, 1);
+
+	tot_blks = UT_TOTAL_BLKS / (1 << 12) - 1;
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_free_transient, tot_blks - 9);
+	assert_int_equal(stat.vs_resrv_small, 2);
+
+	/* Publish the first one, cancel the second one */
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	d_list_del_init(&ext->vre_link);
+	d_list_add(&ext->vre_link, &args.vua_resrvd_list[1]);
+
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_int_equal(rc, 0);
+	rc = vea_tx_publish(args.vua_vsi, NULL, r_list);
+	assert_int_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_int_equal(rc, 0);
+
+	rc = vea_cancel(args.vua_vsi, NULL, &args.vua_resrvd_list[1]);
+	assert_rc_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b, 8);
+	assert_rc_equal(rc, 1);
+
+	/* The canceled blocks are reused by next small reserve */
+	rc = vea_reserve(args.vua_vsi, 4, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	assert_int_equal(ext->vre_blk_off, off_b);
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+
+	/* Free the published block, the empty chunk is returned on migration */
+	blk_off = off_a;
+	rc = vea_free(args.vua_vsi, blk_off, 1);
+	assert_rc_equal(rc, 0);
+	vea_flush(args.vua_vsi, true);
+
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_free_transient, tot_blks);
+	assert_int_equal(stat.vs_largest_blks, tot_blks);
+	assert_int_equal(bitmap_free_blks(args.vua_vsi), 0);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
 static void
 ut_inval_params_format(void **state)
 {
@@ -1273,6 +1440,8 @@ static const struct CMUnitTest vea_uts[] = {
 	{ "vea_hint_unload", ut_hint_unload, NULL, NULL},
 	{ "vea_unload", ut_unload, NULL, NULL},
 	{ "vea_reserve_special", ut_reserve_special, NULL, NULL},
+	{ "vea_magazine", ut_magazine, NULL, NULL},
+	{ "vea_bitmap", ut_bitmap, NULL, NULL},
 	{ "vea_inval_params_format", ut_inval_params_format, NULL, NULL},
 	{ "vea_inval_params_load", ut_inval_params_load, NULL, NULL},
 	{ "vea_inval_param_reserve", ut_inval_params_reserve, NULL, NULL},
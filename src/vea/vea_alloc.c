@@ -213,8 +213,8 @@ reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
 			vfe.vfe_blk_cnt = tot_blks - half_blks - blk_cnt;
 			vfe.vfe_age = 0;	/* Not used */
 
-			rc = compound_free(vsi, &vfe, VEA_FL_NO_MERGE |
-						VEA_FL_NO_ACCOUNTING);
+			rc = compound_free(vsi, &vfe, VEA_FL_NO_MERGE | VEA_FL_NO_ACCOUNTING |
+						VEA_FL_NO_BITMAP);
 			if (rc)
 				return rc;
 		}
@@ -240,6 +240,221 @@ reserve_vector(struct vea_space_info *vsi, uint32_t blk_cnt,
 	return -DER_NOSPACE;
 }
 
+/*
+ * Carve a free extent of @blk_cnt from compound index without accounting it
+ * as reserved, the best-fit small free extent is preferred, otherwise carve
+ * from the head of the largest free extent. vfe_blk_cnt of @vfe is set to 0
+ * if there isn't any free extent large enough.
+ */
+int
+carve_free_ext(struct vea_space_info *vsi, uint32_t blk_cnt, struct vea_free_extent *vfe)
+{
+	struct vea_free_class	*vfc = &vsi->vsi_class;
+	struct vea_entry	*entry = NULL;
+	int			 rc;
+
+	vfe->vfe_blk_cnt = 0;
+	vfe->vfe_age = 0;	/* Not used */
+
+	if (blk_cnt <= vfc->vfc_large_thresh) {
+		struct vea_sized_class	*sc;
+		d_iov_t			 key, val_out;
+		uint64_t		 int_key = blk_cnt;
+
+		d_iov_set(&key, &int_key, sizeof(int_key));
+		d_iov_set(&val_out, NULL, 0);
+
+		rc = dbtree_fetch(vfc->vfc_size_btr, BTR_PROBE_GE, DAOS_INTENT_DEFAULT, &key,
+				  NULL, &val_out);
+		if (rc == 0) {
+			sc = (struct vea_sized_class *)val_out.iov_buf;
+			D_ASSERT(sc != NULL && !d_list_empty(&sc->vsc_lru));
+			entry = d_list_entry(sc->vsc_lru.next, struct vea_entry, ve_link);
+		} else if (rc != -DER_NONEXIST) {
+			D_ERROR("Search size class:%u failed. "DF_RC"\n", blk_cnt, DP_RC(rc));
+			return rc;
+		}
+	}
+
+	if (entry == NULL && !d_binheap_is_empty(&vfc->vfc_heap)) {
+		entry = container_of(d_binheap_root(&vfc->vfc_heap), struct vea_entry, ve_node);
+		if (entry->ve_ext.vfe_blk_cnt < blk_cnt)
+			entry = NULL;
+	}
+
+	if (entry == NULL)
+		return 0;
+
+	vfe->vfe_blk_off = entry->ve_ext.vfe_blk_off;
+	vfe->vfe_blk_cnt = blk_cnt;
+
+	rc = compound_alloc(vsi, vfe, entry);
+	if (rc)
+		vfe->vfe_blk_cnt = 0;
+	return rc;
+}
+
+/*
+ * Carve a batch of @blk_cnt sized extents out of a single free extent, the
+ * batch is pushed in descending offset order, so that extents popped from
+ * the magazine are contiguous. Blocks cached in magazine are still counted
+ * as free blocks.
+ */
+static int
+magazine_refill(struct vea_space_info *vsi, struct vea_magazine *mag,
+		uint32_t blk_cnt)
+{
+	struct vea_free_extent	 vfe;
+	uint32_t		 batch = max(vsi->vsi_mag_depth >> 1, 1U);
+	int			 rc;
+
+	D_ASSERT(mag->vm_nr == 0);
+
+	/* Leave the fragmented space to the regular reserve path */
+	rc = carve_free_ext(vsi, blk_cnt * batch, &vfe);
+	if (rc != 0 || vfe.vfe_blk_cnt == 0)
+		return rc;
+
+	while (batch > 0) {
+		batch--;
+		mag->vm_blk_off[mag->vm_nr++] = vfe.vfe_blk_off + batch * blk_cnt;
+	}
+
+	return 0;
+}
+
+/* Reserve from the magazine of @blk_cnt, refill it from compound index if it's empty */
+int
+reserve_magazine(struct vea_space_info *vsi, uint32_t blk_cnt,
+		 struct vea_resrvd_ext *resrvd)
+{
+	struct vea_magazine	*mag;
+	int			 rc;
+
+	if (vsi->vsi_mags == NULL || blk_cnt > VEA_MAG_CLASS_MAX)
+		return 0;
+
+	mag = &vsi->vsi_mags[blk_cnt - 1];
+	if (mag->vm_nr == 0) {
+		rc = magazine_refill(vsi, mag, blk_cnt);
+		if (rc != 0 || mag->vm_nr == 0)
+			return rc;
+	}
+
+	resrvd->vre_blk_off = mag->vm_blk_off[--mag->vm_nr];
+	resrvd->vre_blk_cnt = blk_cnt;
+	inc_stats(vsi, STAT_RESRV_SMALL, 1);
+
+	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off, resrvd->vre_blk_cnt);
+
+	return 0;
+}
+
+/*
+ * Return a canceled extent to its magazine, the extent will be reused by the
+ * next reserve of the same size.
+ *
+ * Return value:	true	- Extent cached in magazine
+ *			false	- Magazine disabled or full
+ */
+bool
+magazine_put(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vea_magazine *mag;
+
+	if (vsi->vsi_mags == NULL || blk_cnt > VEA_MAG_CLASS_MAX)
+		return false;
+
+	mag = &vsi->vsi_mags[blk_cnt - 1];
+	if (mag->vm_nr >= vsi->vsi_mag_depth)
+		return false;
+
+	mag->vm_blk_off[mag->vm_nr++] = blk_off;
+	inc_stats(vsi, STAT_FREE_BLKS, blk_cnt);
+
+	return true;
+}
+
+/* Return all the cached extents to compound index, so that they can be coalesced */
+int
+magazine_drain(struct vea_space_info *vsi)
+{
+	struct vea_magazine	*mag;
+	struct vea_free_extent	 vfe;
+	int			 i, rc;
+
+	if (vsi->vsi_mags == NULL)
+		return 0;
+
+	vfe.vfe_age = 0;	/* Not used */
+	for (i = 0; i < VEA_MAG_CLASS_MAX; i++) {
+		mag = &vsi->vsi_mags[i];
+		vfe.vfe_blk_cnt = i + 1;
+
+		while (mag->vm_nr > 0) {
+			vfe.vfe_blk_off = mag->vm_blk_off[mag->vm_nr - 1];
+			rc = compound_free(vsi, &vfe, VEA_FL_NO_ACCOUNTING);
+			if (rc) {
+				D_ERROR("Drain ["DF_U64", %u] failed. "DF_RC"\n",
+					vfe.vfe_blk_off, vfe.vfe_blk_cnt, DP_RC(rc));
+				return rc;
+			}
+			mag->vm_nr--;
+		}
+	}
+
+	return 0;
+}
+
+uint64_t
+magazine_free_blks(struct vea_space_info *vsi)
+{
+	uint64_t	free_blks = 0;
+	int		i;
+
+	if (vsi->vsi_mags == NULL)
+		return 0;
+
+	for (i = 0; i < VEA_MAG_CLASS_MAX; i++)
+		free_blks += (uint64_t)vsi->vsi_mags[i].vm_nr * (i + 1);
+
+	return free_blks;
+}
+
+/*
+ * Check if an extent is cached in magazines.
+ *
+ * Return value:	0	- Not cached
+ *			1	- Cached
+ *			-ve	- Partially overlapped with cached extent
+ */
+int
+magazine_verify(struct vea_space_info *vsi, struct vea_free_extent *vfe)
+{
+	struct vea_magazine	*mag;
+	uint64_t		 off;
+	int			 i, j;
+
+	if (vsi->vsi_mags == NULL)
+		return 0;
+
+	for (i = 0; i < VEA_MAG_CLASS_MAX; i++) {
+		mag = &vsi->vsi_mags[i];
+		for (j = 0; j < mag->vm_nr; j++) {
+			off = mag->vm_blk_off[j];
+			if (off + i + 1 <= vfe->vfe_blk_off ||
+			    vfe->vfe_blk_off + vfe->vfe_blk_cnt <= off)
+				continue;
+			if (off <= vfe->vfe_blk_off &&
+			    off + i + 1 >= vfe->vfe_blk_off + vfe->vfe_blk_cnt)
+				return 1;
+			return -DER_INVAL;
+		}
+	}
+
+	return 0;
+}
+
 int
 persistent_alloc(struct vea_space_info *vsi, struct vea_free_extent *vfe)
 {
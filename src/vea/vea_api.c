@@ -165,6 +165,8 @@ vea_unload(struct vea_space_info *vsi)
 {
 	D_ASSERT(vsi != NULL);
 	unload_space_info(vsi);
+	D_FREE(vsi->vsi_mags);
+	bitmap_fini(vsi);
 
 	/* Destroy the in-memory free extent tree */
 	if (daos_handle_is_valid(vsi->vsi_free_btr)) {
@@ -199,6 +201,8 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 {
 	struct umem_attr uma;
 	struct vea_space_info *vsi;
+	unsigned int mag_depth = 0;
+	bool bitmap = false;
 	int rc;
 
 	D_ASSERT(umem != NULL);
@@ -225,6 +229,8 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	D_INIT_LIST_HEAD(&vsi->vsi_agg_lru);
 	vsi->vsi_agg_btr = DAOS_HDL_INVAL;
 	vsi->vsi_vec_btr = DAOS_HDL_INVAL;
+	D_INIT_LIST_HEAD(&vsi->vsi_bitmap_lru);
+	vsi->vsi_bitmap_btr = DAOS_HDL_INVAL;
 	vsi->vsi_agg_time = 0;
 	vsi->vsi_agg_scheduled = false;
 	vsi->vsi_unmap_ctxt = *unmap_ctxt;
@@ -234,6 +240,17 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	if (rc)
 		goto error;
 
+	/* Magazine depth for small extents, magazines are disabled by default */
+	d_getenv_int("DAOS_VEA_MAG_DEPTH", &mag_depth);
+	if (mag_depth > 0) {
+		vsi->vsi_mag_depth = min(mag_depth, VEA_MAG_DEPTH_MAX);
+		D_ALLOC_ARRAY(vsi->vsi_mags, VEA_MAG_CLASS_MAX);
+		if (vsi->vsi_mags == NULL) {
+			rc = -DER_NOMEM;
+			goto error;
+		}
+	}
+
 	memset(&uma, 0, sizeof(uma));
 	uma.uma_id = UMEM_CLASS_VMEM;
 	/* Create in-memory free extent tree */
@@ -259,6 +276,14 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	if (rc)
 		goto error;
 
+	/* Serve small reserves from bitmap chunks, disabled by default */
+	d_getenv_bool("DAOS_VEA_BITMAP", &bitmap);
+	if (bitmap) {
+		rc = bitmap_init(vsi);
+		if (rc)
+			goto error;
+	}
+
 	*vsip = vsi;
 	return 0;
 error:
@@ -270,12 +295,16 @@ error:
  * Reserve an extent on block device, reserve attempting order:
  *
  * 1. Reserve from the free extent with 'hinted' start offset. (lookup vsi_free_btr)
- * 2. If the largest free extent is large enough for splitting, divide it in
+ * 2. Reserve from the magazine of the requested size if magazines are enabled,
+ *    an empty magazine is refilled in batch. (vsi_mags)
+ * 3. Reserve small extent (< VEA_BITMAP_MAX_BLKS) from bitmap chunks if bitmaps
+ *    are enabled, a new chunk is carved when the chunks are full. (vsi_bitmap_lru)
+ * 4. If the largest free extent is large enough for splitting, divide it in
  *    half-and-half then reserve from the latter half. (lookup vfc_heap). Otherwise;
- * 3. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
+ * 5. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
  *    if it fails, reserve from the largest free extent. (lookup vfc_size_btr)
- * 4. Repeat the search in 3rd step to reserve an extent vector. (vsi_vec_btr)
- * 5. Fail reserve with ENOMEM if all above attempts fail.
+ * 6. Repeat the search in 5th step to reserve an extent vector. (vsi_vec_btr)
+ * 7. Fail reserve with ENOMEM if all above attempts fail.
  */
 int
 vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
@@ -299,6 +328,10 @@ vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
 	hint_get(hint, &resrvd->vre_hint_off);
 
 retry:
+	/* Make the aging frees visible right away when the space is running out */
+	if (migrate_expedite(vsi, blk_cnt))
+		vsi->vsi_agg_time = 0;
+
 	/* Trigger free extents migration */
 	migrate_free_exts(vsi, false);
 
@@ -309,6 +342,20 @@ retry:
 	else if (resrvd->vre_blk_cnt != 0)
 		goto done;
 
+	/* Reserve from the magazine */
+	rc = reserve_magazine(vsi, blk_cnt, resrvd);
+	if (rc != 0)
+		goto error;
+	else if (resrvd->vre_blk_cnt != 0)
+		goto done;
+
+	/* Reserve from bitmap chunks */
+	rc = reserve_bitmap(vsi, blk_cnt, resrvd);
+	if (rc != 0)
+		goto error;
+	else if (resrvd->vre_blk_cnt != 0)
+		goto done;
+
 	/* Reserve from the largest extent or a small extent */
 	rc = reserve_single(vsi, blk_cnt, resrvd);
 	if (rc != 0)
@@ -320,6 +367,12 @@ retry:
 	rc = reserve_vector(vsi, blk_cnt, resrvd);
 
 	if (rc == -DER_NOSPACE && retry) {
+		/* Return cached extents and chunks for coalescing */
+		rc = magazine_drain(vsi);
+		if (rc == 0)
+			rc = bitmap_drain(vsi);
+		if (rc != 0)
+			goto error;
 		vsi->vsi_agg_time = 0; /* force free extents migration */
 		retry = false;
 		goto retry;
@@ -379,6 +432,10 @@ process_resrvd_list(struct vea_space_info *vsi, struct vea_hint_context *hint,
 		seq_max = resrvd->vre_hint_seq;
 		off_p = resrvd->vre_blk_off + resrvd->vre_blk_cnt;
 
+		/* Expedited cancel, bypass the compound index */
+		if (!publish && magazine_put(vsi, resrvd->vre_blk_off, resrvd->vre_blk_cnt))
+			continue;
+
 		if (vfe.vfe_blk_off + vfe.vfe_blk_cnt == resrvd->vre_blk_off) {
 			vfe.vfe_blk_cnt += resrvd->vre_blk_cnt;
 			continue;
@@ -662,7 +719,7 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 		if (rc != 0)
 			return rc;
 
-		stat->vs_free_transient = 0;
+		stat->vs_free_transient = magazine_free_blks(vsi) + bitmap_free_blks(vsi);
 		rc = dbtree_iterate(vsi->vsi_free_btr, DAOS_INTENT_DEFAULT,
 				    false, count_free_transient,
 				    (void *)&stat->vs_free_transient);
@@ -675,6 +732,8 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 		stat->vs_frags_large = vsi->vsi_stat[STAT_FRAGS_LARGE];
 		stat->vs_frags_small = vsi->vsi_stat[STAT_FRAGS_SMALL];
 		stat->vs_frags_aging = vsi->vsi_stat[STAT_FRAGS_AGING];
+		stat->vs_largest_blks = largest_free_ext(vsi);
+		update_frag_stats(vsi);
 	}
 
 	return 0;
@@ -685,6 +744,12 @@ vea_flush(struct vea_space_info *vsi, bool force)
 {
 	D_ASSERT(vsi != NULL);
 
+	/* Return cached extents and chunks for coalescing */
+	if (force) {
+		magazine_drain(vsi);
+		bitmap_drain(vsi);
+	}
+
 	if (d_list_empty(&vsi->vsi_agg_lru))
 		return 0;
 
@@ -0,0 +1,365 @@
+/**
+ * (C) Copyright 2018-2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include <daos/common.h>
+#include <daos/btree_class.h>
+#include "vea_internal.h"
+
+int
+bitmap_init(struct vea_space_info *vsi)
+{
+	struct umem_attr	uma = {0};
+
+	uma.uma_id = UMEM_CLASS_VMEM;
+	/* Create in-memory bitmap chunk tree */
+	return dbtree_create(DBTREE_CLASS_IV, BTR_FEAT_DIRECT_KEY, VEA_TREE_ODR,
+			     &uma, NULL, &vsi->vsi_bitmap_btr);
+}
+
+void
+bitmap_fini(struct vea_space_info *vsi)
+{
+	if (daos_handle_is_valid(vsi->vsi_bitmap_btr)) {
+		dbtree_destroy(vsi->vsi_bitmap_btr, NULL);
+		vsi->vsi_bitmap_btr = DAOS_HDL_INVAL;
+	}
+	D_INIT_LIST_HEAD(&vsi->vsi_bitmap_lru);
+}
+
+/*
+ * First-fit search for @blk_cnt free blocks in the chunk, return -1 if not found.
+ * The search starts from the free hint, and a failed search records the longest
+ * free run, so the chunk is skipped by larger reserves until some blocks are freed.
+ */
+static int
+chunk_find_free(struct vea_bitmap_chunk *vbc, uint32_t blk_cnt)
+{
+	uint32_t	idx, run = 0, max_run = 0;
+
+	if (vbc->vbc_used + blk_cnt > VEA_BITMAP_CHUNK_BLKS || blk_cnt > vbc->vbc_max_run)
+		return -1;
+
+	for (idx = vbc->vbc_hint; idx < VEA_BITMAP_CHUNK_BLKS; idx++) {
+		if (isset(vbc->vbc_bits, idx)) {
+			max_run = max(max_run, run);
+			run = 0;
+			continue;
+		}
+		if (++run == blk_cnt)
+			return idx + 1 - blk_cnt;
+	}
+
+	vbc->vbc_max_run = max(max_run, run);
+	return -1;
+}
+
+/* Carve a new chunk from compound index */
+static int
+chunk_create(struct vea_space_info *vsi, struct vea_bitmap_chunk **vbc_out)
+{
+	struct vea_bitmap_chunk	 dummy, *vbc;
+	struct vea_free_extent	 vfe;
+	d_iov_t			 key, val, val_out;
+	int			 rc;
+
+	*vbc_out = NULL;
+	rc = carve_free_ext(vsi, VEA_BITMAP_CHUNK_BLKS, &vfe);
+	if (rc != 0 || vfe.vfe_blk_cnt == 0)
+		return rc;
+
+	memset(&dummy, 0, sizeof(dummy));
+	dummy.vbc_blk_off = vfe.vfe_blk_off;
+	dummy.vbc_max_run = VEA_BITMAP_CHUNK_BLKS;
+
+	d_iov_set(&key, &dummy.vbc_blk_off, sizeof(dummy.vbc_blk_off));
+	d_iov_set(&val, &dummy, sizeof(dummy));
+	d_iov_set(&val_out, NULL, 0);
+
+	rc = dbtree_upsert(vsi->vsi_bitmap_btr, BTR_PROBE_EQ, DAOS_INTENT_UPDATE, &key,
+			   &val, &val_out);
+	if (rc != 0) {
+		D_ERROR("Insert bitmap chunk "DF_U64" failed. "DF_RC"\n",
+			vfe.vfe_blk_off, DP_RC(rc));
+		/* Give the carved space back */
+		compound_free(vsi, &vfe, VEA_FL_NO_ACCOUNTING | VEA_FL_NO_BITMAP);
+		return rc;
+	}
+
+	D_ASSERT(val_out.iov_buf != NULL);
+	vbc = (struct vea_bitmap_chunk *)val_out.iov_buf;
+	D_INIT_LIST_HEAD(&vbc->vbc_link);
+	d_list_add(&vbc->vbc_link, &vsi->vsi_bitmap_lru);
+
+	*vbc_out = vbc;
+	return 0;
+}
+
+/*
+ * Return all free blocks of a chunk to compound index and remove the chunk,
+ * allocated blocks of the chunk will be freed to compound index directly.
+ */
+static int
+chunk_release(struct vea_space_info *vsi, struct vea_bitmap_chunk *vbc)
+{
+	struct vea_free_extent	vfe;
+	d_iov_t			key;
+	uint64_t		blk_off = vbc->vbc_blk_off;
+	uint32_t		idx, start = 0;
+	int			rc;
+
+	d_list_del_init(&vbc->vbc_link);
+
+	vfe.vfe_age = 0;	/* Not used */
+	for (idx = 0; idx <= VEA_BITMAP_CHUNK_BLKS; idx++) {
+		if (idx < VEA_BITMAP_CHUNK_BLKS && isclr(vbc->vbc_bits, idx))
+			continue;
+
+		if (idx > start) {
+			vfe.vfe_blk_off = blk_off + start;
+			vfe.vfe_blk_cnt = idx - start;
+			rc = compound_free(vsi, &vfe, VEA_FL_NO_ACCOUNTING | VEA_FL_NO_BITMAP);
+			if (rc) {
+				D_ERROR("Release ["DF_U64", %u] failed. "DF_RC"\n",
+					vfe.vfe_blk_off, vfe.vfe_blk_cnt, DP_RC(rc));
+				return rc;
+			}
+		}
+		start = idx + 1;
+	}
+
+	/* The chunk will be freed on deletion */
+	d_iov_set(&key, &blk_off, sizeof(blk_off));
+	rc = dbtree_delete(vsi->vsi_bitmap_btr, BTR_PROBE_EQ, &key, NULL);
+	if (rc)
+		D_ERROR("Remove bitmap chunk "DF_U64" failed. "DF_RC"\n", blk_off, DP_RC(rc));
+	return rc;
+}
+
+/*
+ * Reserve small extent from bitmap chunks, the most recently used chunk is
+ * tried first, a new chunk is carved when none of the chunks has enough
+ * contiguous free blocks.
+ */
+int
+reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
+	       struct vea_resrvd_ext *resrvd)
+{
+	struct vea_bitmap_chunk	*vbc;
+	uint32_t		 hint;
+	int			 idx = -1, rc;
+
+	if (daos_handle_is_inval(vsi->vsi_bitmap_btr) || blk_cnt >= VEA_BITMAP_MAX_BLKS)
+		return 0;
+
+	d_list_for_each_entry(vbc, &vsi->vsi_bitmap_lru, vbc_link) {
+		idx = chunk_find_free(vbc, blk_cnt);
+		if (idx >= 0)
+			break;
+	}
+
+	if (idx < 0) {
+		rc = chunk_create(vsi, &vbc);
+		if (rc != 0 || vbc == NULL)
+			return rc;
+		idx = 0;
+	}
+
+	setbit_range(vbc->vbc_bits, idx, idx + blk_cnt - 1);
+	vbc->vbc_used += blk_cnt;
+	if (idx == vbc->vbc_hint) {
+		hint = idx + blk_cnt;
+		while (hint < VEA_BITMAP_CHUNK_BLKS && isset(vbc->vbc_bits, hint))
+			hint++;
+		vbc->vbc_hint = hint;
+	}
+
+	/* Move the chunk to head, or remove it from LRU when it's full */
+	d_list_del_init(&vbc->vbc_link);
+	if (vbc->vbc_used < VEA_BITMAP_CHUNK_BLKS)
+		d_list_add(&vbc->vbc_link, &vsi->vsi_bitmap_lru);
+
+	resrvd->vre_blk_off = vbc->vbc_blk_off + idx;
+	resrvd->vre_blk_cnt = blk_cnt;
+	inc_stats(vsi, STAT_RESRV_SMALL, 1);
+
+	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off, resrvd->vre_blk_cnt);
+
+	return 0;
+}
+
+/* Lookup the chunk covering or following @blk_off */
+static int
+chunk_lookup(struct vea_space_info *vsi, uint64_t blk_off, int opc,
+	     struct vea_bitmap_chunk **vbc)
+{
+	d_iov_t	key, val;
+	int	rc;
+
+	d_iov_set(&key, &blk_off, sizeof(blk_off));
+	d_iov_set(&val, NULL, 0);
+
+	rc = dbtree_fetch(vsi->vsi_bitmap_btr, opc, DAOS_INTENT_DEFAULT, &key, NULL, &val);
+	if (rc == 0)
+		*vbc = (struct vea_bitmap_chunk *)val.iov_buf;
+	else
+		*vbc = NULL;
+
+	return rc == -DER_NONEXIST ? 0 : rc;
+}
+
+/*
+ * Free extent to bitmap chunks, the extent could be coalesced in aggregate
+ * tree, so it's split into the parts within chunks and the parts outside of
+ * chunks, the latter are freed to compound index.
+ */
+int
+bitmap_free(struct vea_space_info *vsi, struct vea_free_extent *vfe,
+	    unsigned int flags)
+{
+	struct vea_bitmap_chunk	*vbc;
+	struct vea_free_extent	 part;
+	uint64_t		 cur = vfe->vfe_blk_off;
+	uint64_t		 end = vfe->vfe_blk_off + vfe->vfe_blk_cnt;
+	uint64_t		 chunk_end;
+	uint32_t		 idx;
+	int			 rc;
+
+	D_ASSERT(daos_handle_is_valid(vsi->vsi_bitmap_btr));
+	part.vfe_age = vfe->vfe_age;
+
+	while (cur < end) {
+		rc = chunk_lookup(vsi, cur, BTR_PROBE_LE, &vbc);
+		if (rc)
+			return rc;
+
+		if (vbc != NULL && cur < vbc->vbc_blk_off + VEA_BITMAP_CHUNK_BLKS) {
+			chunk_end = min(end, vbc->vbc_blk_off + VEA_BITMAP_CHUNK_BLKS);
+			idx = cur - vbc->vbc_blk_off;
+
+			if (!isset_range(vbc->vbc_bits, idx, chunk_end - vbc->vbc_blk_off - 1)) {
+				D_ERROR("Free unallocated ["DF_U64", "DF_U64"] in chunk "DF_U64"\n",
+					cur, chunk_end - cur, vbc->vbc_blk_off);
+				return -DER_INVAL;
+			}
+
+			clrbit_range(vbc->vbc_bits, idx, chunk_end - vbc->vbc_blk_off - 1);
+			D_ASSERT(vbc->vbc_used >= chunk_end - cur);
+			vbc->vbc_used -= chunk_end - cur;
+			vbc->vbc_hint = min(vbc->vbc_hint, idx);
+			vbc->vbc_max_run = VEA_BITMAP_CHUNK_BLKS;
+			if (!(flags & VEA_FL_NO_ACCOUNTING))
+				inc_stats(vsi, STAT_FREE_BLKS, chunk_end - cur);
+			cur = chunk_end;
+
+			if (vbc->vbc_used == 0) {
+				rc = chunk_release(vsi, vbc);
+				if (rc)
+					return rc;
+			} else if (d_list_empty(&vbc->vbc_link)) {
+				d_list_add_tail(&vbc->vbc_link, &vsi->vsi_bitmap_lru);
+			}
+			continue;
+		}
+
+		/* Free the part before next chunk to compound index */
+		rc = chunk_lookup(vsi, cur, BTR_PROBE_GE, &vbc);
+		if (rc)
+			return rc;
+
+		part.vfe_blk_off = cur;
+		part.vfe_blk_cnt = vbc != NULL ? min(end, vbc->vbc_blk_off) - cur : end - cur;
+		rc = compound_free(vsi, &part, flags | VEA_FL_NO_BITMAP);
+		if (rc)
+			return rc;
+		cur += part.vfe_blk_cnt;
+	}
+
+	return 0;
+}
+
+/* Release all the bitmap chunks, so that the free blocks can be coalesced */
+int
+bitmap_drain(struct vea_space_info *vsi)
+{
+	struct vea_bitmap_chunk	*vbc;
+	int			 rc;
+
+	if (daos_handle_is_inval(vsi->vsi_bitmap_btr))
+		return 0;
+
+	while (1) {
+		rc = chunk_lookup(vsi, 0, BTR_PROBE_FIRST, &vbc);
+		if (rc != 0 || vbc == NULL)
+			return rc;
+
+		rc = chunk_release(vsi, vbc);
+		if (rc)
+			return rc;
+	}
+}
+
+static int
+count_chunk_free(daos_handle_t ih, d_iov_t *key, d_iov_t *val, void *arg)
+{
+	struct vea_bitmap_chunk	*vbc = (struct vea_bitmap_chunk *)val->iov_buf;
+	uint64_t		*free_blks = arg;
+
+	*free_blks += VEA_BITMAP_CHUNK_BLKS - vbc->vbc_used;
+	return 0;
+}
+
+uint64_t
+bitmap_free_blks(struct vea_space_info *vsi)
+{
+	uint64_t	free_blks = 0;
+	int		rc;
+
+	if (daos_handle_is_inval(vsi->vsi_bitmap_btr))
+		return 0;
+
+	rc = dbtree_iterate(vsi->vsi_bitmap_btr, DAOS_INTENT_DEFAULT, false,
+			    count_chunk_free, &free_blks);
+	if (rc)
+		D_ERROR("Count bitmap free blocks failed. "DF_RC"\n", DP_RC(rc));
+
+	return free_blks;
+}
+
+/*
+ * Check if an extent is free in bitmap chunks.
+ *
+ * Return value:	0	- Not in chunk, or allocated in chunk
+ *			1	- Free in chunk
+ *			-ve	- Partially free in chunk
+ */
+int
+bitmap_verify(struct vea_space_info *vsi, struct vea_free_extent *vfe)
+{
+	struct vea_bitmap_chunk	*vbc;
+	uint32_t		 idx, last;
+	int			 rc;
+
+	if (daos_handle_is_inval(vsi->vsi_bitmap_btr))
+		return 0;
+
+	rc = chunk_lookup(vsi, vfe->vfe_blk_off, BTR_PROBE_LE, &vbc);
+	if (rc != 0 || vbc == NULL ||
+	    vfe->vfe_blk_off >= vbc->vbc_blk_off + VEA_BITMAP_CHUNK_BLKS)
+		return rc;
+
+	idx = vfe->vfe_blk_off - vbc->vbc_blk_off;
+	last = min(idx + vfe->vfe_blk_cnt, VEA_BITMAP_CHUNK_BLKS) - 1;
+
+	if (isset_range(vbc->vbc_bits, idx, last))
+		return 0;
+	for (; idx <= last; idx++) {
+		if (isset(vbc->vbc_bits, idx))
+			return -DER_INVAL;
+	}
+	return last - (vfe->vfe_blk_off - vbc->vbc_blk_off) + 1 == vfe->vfe_blk_cnt ?
+	       1 : -DER_INVAL;
+}
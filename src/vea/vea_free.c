@@ -331,6 +331,10 @@ compound_free(struct vea_space_info *vsi, struct vea_free_extent *vfe,
 	d_iov_t			 key, val, val_out;
 	int			 rc;
 
+	/* Blocks allocated from bitmap chunks are freed to the chunks */
+	if (daos_handle_is_valid(vsi->vsi_bitmap_btr) && !(flags & VEA_FL_NO_BITMAP))
+		return bitmap_free(vsi, vfe, flags);
+
 	rc = merge_free_ext(vsi, vfe, VEA_TYPE_COMPOUND, flags);
 	if (rc < 0) {
 		return rc;
@@ -527,6 +531,7 @@ migrate_end_cb(void *data, bool noop)
 	/* Update aggregation time before yield */
 	vsi->vsi_agg_time = cur_time;
 	vsi->vsi_agg_scheduled = false;
+	update_frag_stats(vsi);
 
 	/*
 	 * According to NVMe spec, unmap isn't an expensive non-queue command
@@ -560,6 +565,23 @@ migrate_end_cb(void *data, bool noop)
 	}
 }
 
+/*
+ * Check if the aging free extents should be migrated without waiting for
+ * VEA_MIGRATE_INTVL, that's when the allocatable space can't satisfy the
+ * reserve of @blk_cnt, or when too many frags are piled up in aging buffer.
+ */
+bool
+migrate_expedite(struct vea_space_info *vsi, uint32_t blk_cnt)
+{
+	if (d_list_empty(&vsi->vsi_agg_lru))
+		return false;
+
+	if (vsi->vsi_stat[STAT_FRAGS_AGING] >= MAX_FLUSH_FRAGS)
+		return true;
+
+	return vsi->vsi_stat[STAT_FREE_BLKS] < blk_cnt;
+}
+
 void
 migrate_free_exts(struct vea_space_info *vsi, bool add_tx_cb)
 {
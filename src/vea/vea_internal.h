@@ -44,6 +44,42 @@ struct vea_entry {
 #define VEA_LARGE_EXT_MB	64	/* Large extent threshold in MB */
 #define VEA_HINT_OFF_INVAL	0	/* Invalid hint offset */
 #define VEA_MIGRATE_INTVL	10	/* Seconds */
+#define VEA_MAG_CLASS_MAX	16	/* Max block count served by magazines */
+#define VEA_MAG_DEPTH_MAX	64	/* Max extents cached in a magazine */
+
+/*
+ * Magazine of free extents with identical size, carved from the compound
+ * index in batches, so that small reserve & cancel don't touch the trees.
+ */
+struct vea_magazine {
+	uint64_t	vm_blk_off[VEA_MAG_DEPTH_MAX];
+	uint32_t	vm_nr;
+};
+
+#define VEA_BITMAP_CHUNK_BLKS	256	/* Blocks per bitmap chunk (1MB with 4K block) */
+#define VEA_BITMAP_MAX_BLKS	16	/* Reserve smaller than this is served by bitmaps */
+
+/*
+ * Chunk carved from compound index for small reserves, small blocks are
+ * allocated within the chunk by bitmap, so they don't shatter the free
+ * extents. Chunks are tracked in vsi_bitmap_btr.
+ */
+struct vea_bitmap_chunk {
+	/*
+	 * Always keep it as first item, since vbc_blk_off is the direct key
+	 * of DBTREE_CLASS_IV
+	 */
+	uint64_t	vbc_blk_off;
+	/* Link to vsi_bitmap_lru, for chunks having free blocks */
+	d_list_t	vbc_link;
+	/* Allocated blocks in the chunk */
+	uint32_t	vbc_used;
+	/* All blocks below this index are allocated */
+	uint16_t	vbc_hint;
+	/* Upper bound of the longest free run in the chunk */
+	uint16_t	vbc_max_run;
+	uint8_t		vbc_bits[VEA_BITMAP_CHUNK_BLKS / NBBY];
+};
 
 /* Value entry of sized free extent tree (vfc_size_btr) */
 struct vea_sized_class {
@@ -90,6 +126,8 @@ struct vea_metrics {
 	struct d_tm_node_t	*vm_rsrv[STAT_RESRV_TYPE_MAX];
 	struct d_tm_node_t	*vm_frags[STAT_FRAGS_TYPE_MAX];
 	struct d_tm_node_t	*vm_free_blks;
+	struct d_tm_node_t	*vm_largest_blks;
+	struct d_tm_node_t	*vm_frag_ratio;
 };
 
 /* In-memory compound index */
@@ -128,6 +166,14 @@ struct vea_space_info {
 	uint64_t			 vsi_stat[STAT_MAX];
 	/* Metrics */
 	struct vea_metrics		*vsi_metrics;
+	/* Magazines for 1 ~ VEA_MAG_CLASS_MAX blocks, NULL if disabled */
+	struct vea_magazine		*vsi_mags;
+	/* Magazine depth, half of it is refilled each time */
+	uint32_t			 vsi_mag_depth;
+	/* Bitmap chunks sorted by offset, DAOS_HDL_INVAL if disabled */
+	daos_handle_t			 vsi_bitmap_btr;
+	/* Bitmap chunks having free blocks */
+	d_list_t			 vsi_bitmap_lru;
 	/* Last aggregation time */
 	uint32_t			 vsi_agg_time;
 	bool				 vsi_agg_scheduled;
@@ -145,6 +191,8 @@ get_current_age(void)
 enum vea_free_flags {
 	VEA_FL_NO_MERGE		= (1 << 0),
 	VEA_FL_NO_ACCOUNTING	= (1 << 1),
+	/* Free to compound index directly, bypass the bitmap chunks */
+	VEA_FL_NO_BITMAP	= (1 << 2),
 };
 
 /* vea_init.c */
@@ -163,6 +211,8 @@ int vea_verify_alloc(struct vea_space_info *vsi, bool transient,
 		     uint64_t off, uint32_t cnt);
 void dec_stats(struct vea_space_info *vsi, unsigned int type, uint64_t nr);
 void inc_stats(struct vea_space_info *vsi, unsigned int type, uint64_t nr);
+uint64_t largest_free_ext(struct vea_space_info *vsi);
+void update_frag_stats(struct vea_space_info *vsi);
 
 /* vea_alloc.c */
 int compound_vec_alloc(struct vea_space_info *vsi, struct vea_ext_vector *vec);
@@ -173,6 +223,14 @@ int reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
 int reserve_vector(struct vea_space_info *vsi, uint32_t blk_cnt,
 		   struct vea_resrvd_ext *resrvd);
 int persistent_alloc(struct vea_space_info *vsi, struct vea_free_extent *vfe);
+int carve_free_ext(struct vea_space_info *vsi, uint32_t blk_cnt,
+		   struct vea_free_extent *vfe);
+int reserve_magazine(struct vea_space_info *vsi, uint32_t blk_cnt,
+		     struct vea_resrvd_ext *resrvd);
+bool magazine_put(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt);
+int magazine_drain(struct vea_space_info *vsi);
+uint64_t magazine_free_blks(struct vea_space_info *vsi);
+int magazine_verify(struct vea_space_info *vsi, struct vea_free_extent *vfe);
 
 /* vea_free.c */
 void free_class_remove(struct vea_space_info *vsi, struct vea_entry *entry);
@@ -182,6 +240,18 @@ int compound_free(struct vea_space_info *vsi, struct vea_free_extent *vfe,
 int persistent_free(struct vea_space_info *vsi, struct vea_free_extent *vfe);
 int aggregated_free(struct vea_space_info *vsi, struct vea_free_extent *vfe);
 void migrate_free_exts(struct vea_space_info *vsi, bool add_tx_cb);
+bool migrate_expedite(struct vea_space_info *vsi, uint32_t blk_cnt);
+
+/* vea_bitmap.c */
+int bitmap_init(struct vea_space_info *vsi);
+void bitmap_fini(struct vea_space_info *vsi);
+int reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
+		   struct vea_resrvd_ext *resrvd);
+int bitmap_free(struct vea_space_info *vsi, struct vea_free_extent *vfe,
+		unsigned int flags);
+int bitmap_drain(struct vea_space_info *vsi);
+uint64_t bitmap_free_blks(struct vea_space_info *vsi);
+int bitmap_verify(struct vea_space_info *vsi, struct vea_free_extent *vfe);
 
 /* vea_hint.c */
 void hint_get(struct vea_hint_context *hint, uint64_t *off);
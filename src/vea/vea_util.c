@@ -218,10 +218,18 @@ vea_verify_alloc(struct vea_space_info *vsi, bool transient, uint64_t off,
 	if (rc)
 		return rc;
 
-	if (transient)
+	if (transient) {
+		/* Extents cached in magazines are free but not in the tree */
+		rc = magazine_verify(vsi, &vfe);
+		if (rc)
+			return rc;
+		rc = bitmap_verify(vsi, &vfe);
+		if (rc)
+			return rc;
 		btr_hdl = vsi->vsi_free_btr;
-	else
+	} else {
 		btr_hdl = vsi->vsi_md_free_btr;
+	}
 
 	D_ASSERT(daos_handle_is_valid(btr_hdl));
 	d_iov_set(&key, &vfe.vfe_blk_off, sizeof(vfe.vfe_blk_off));
@@ -347,6 +355,18 @@ vea_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create free blks telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->vm_largest_blks, D_TM_GAUGE,
+			     "number of blocks of the largest free extent", "blks",
+			     "%s/%s/largest_blks/tgt_%u", path, VEA_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create largest blks telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->vm_frag_ratio, D_TM_GAUGE,
+			     "free space not in the largest free extent", "%",
+			     "%s/%s/frag_ratio/tgt_%u", path, VEA_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create frag ratio telemetry: "DF_RC"\n", DP_RC(rc));
+
 	return metrics;
 }
 
@@ -413,3 +433,49 @@ inc_stats(struct vea_space_info *vsi, unsigned int type, uint64_t nr)
 {
 	return update_stats(vsi, type, nr, false);
 }
+
+/* Block count of the largest free extent in compound index */
+uint64_t
+largest_free_ext(struct vea_space_info *vsi)
+{
+	struct vea_free_class	*vfc = &vsi->vsi_class;
+	struct vea_entry	*entry;
+	d_iov_t			 key, key_out;
+	uint64_t		 int_key = 0, blk_cnt = 0;
+	int			 rc;
+
+	if (!d_binheap_is_empty(&vfc->vfc_heap)) {
+		entry = container_of(d_binheap_root(&vfc->vfc_heap), struct vea_entry, ve_node);
+		return entry->ve_ext.vfe_blk_cnt;
+	}
+
+	d_iov_set(&key, &int_key, sizeof(int_key));
+	d_iov_set(&key_out, &blk_cnt, sizeof(blk_cnt));
+	rc = dbtree_fetch(vfc->vfc_size_btr, BTR_PROBE_LAST, DAOS_INTENT_DEFAULT, &key,
+			  &key_out, NULL);
+	if (rc && rc != -DER_NONEXIST)
+		D_ERROR("Search the largest size class failed. "DF_RC"\n", DP_RC(rc));
+
+	return rc ? 0 : blk_cnt;
+}
+
+/*
+ * Update the fragmentation telemetry, fragmentation ratio is the percentage
+ * of free blocks not in the largest free extent.
+ */
+void
+update_frag_stats(struct vea_space_info *vsi)
+{
+	struct vea_metrics	*metrics = vsi->vsi_metrics;
+	uint64_t		 largest, free_blks = vsi->vsi_stat[STAT_FREE_BLKS];
+
+	if (metrics == NULL)
+		return;
+
+	largest = largest_free_ext(vsi);
+	if (metrics->vm_largest_blks)
+		d_tm_set_gauge(metrics->vm_largest_blks, largest);
+	if (metrics->vm_frag_ratio)
+		d_tm_set_gauge(metrics->vm_frag_ratio, free_blks == 0 ? 0 :
+			       (free_blks - min(largest, free_blks)) * 100 / free_blks);
+}
@@ -1157,7 +1157,7 @@ evt_tcx_create(struct evt_root *root, uint64_t feats, unsigned int order,
 		V_TRACE(DB_TRACE, "Load tree context from %p\n", root);
 	}
 
-	policy = tcx->tc_feats & EVT_FEATS_SUPPORTED;
+	policy = tcx->tc_feats & EVT_FEATS_POLICY;
 	switch (policy) {
 	case EVT_FEAT_SORT_SOFF:
 		tcx->tc_ops = evt_policies[0];
@@ -1310,6 +1310,82 @@ evt_node_child_at(struct evt_context *tcx, struct evt_node *node,
 	return node->tn_child[at];
 }
 
+/** Intermediate node stores MBRs of its children, see EVT_FEAT_CHILD_MBR */
+static inline bool
+evt_node_has_child_mbr(struct evt_context *tcx, struct evt_node *node)
+{
+	return (tcx->tc_feats & EVT_FEAT_CHILD_MBR) &&
+	       !evt_node_is_leaf(tcx, node);
+}
+
+/**
+ * Child MBRs of an intermediate node follow the child offsets as a struct of
+ * arrays, each array has tree order slots:
+ *
+ *   tn_child[] | ex_lo[] | ex_hi[] | epc[] | minor_epc[]
+ *
+ * Checking the children for overlap only scans the arrays of the node itself
+ * instead of loading every child node.
+ */
+static inline uint64_t *
+evt_child_mbr_lo(struct evt_context *tcx, struct evt_node *node)
+{
+	return &node->tn_child[tcx->tc_order];
+}
+
+static inline uint64_t *
+evt_child_mbr_hi(struct evt_context *tcx, struct evt_node *node)
+{
+	return &node->tn_child[tcx->tc_order * 2];
+}
+
+static inline uint64_t *
+evt_child_mbr_epc(struct evt_context *tcx, struct evt_node *node)
+{
+	return &node->tn_child[tcx->tc_order * 3];
+}
+
+static inline uint16_t *
+evt_child_mbr_minor(struct evt_context *tcx, struct evt_node *node)
+{
+	return (uint16_t *)&node->tn_child[tcx->tc_order * 4];
+}
+
+static void
+evt_child_mbr_read(struct evt_context *tcx, struct evt_node *node,
+		   unsigned int at, struct evt_rect *rout)
+{
+	rout->rc_ex.ex_lo = evt_child_mbr_lo(tcx, node)[at];
+	rout->rc_ex.ex_hi = evt_child_mbr_hi(tcx, node)[at];
+	rout->rc_epc = evt_child_mbr_epc(tcx, node)[at];
+	rout->rc_minor_epc = evt_child_mbr_minor(tcx, node)[at];
+}
+
+static void
+evt_child_mbr_write(struct evt_context *tcx, struct evt_node *node,
+		    unsigned int at, const struct evt_rect *rin)
+{
+	evt_child_mbr_lo(tcx, node)[at] = rin->rc_ex.ex_lo;
+	evt_child_mbr_hi(tcx, node)[at] = rin->rc_ex.ex_hi;
+	evt_child_mbr_epc(tcx, node)[at] = rin->rc_epc;
+	evt_child_mbr_minor(tcx, node)[at] = rin->rc_minor_epc;
+}
+
+/** Copy \a nr child MBRs from \a src_nd[src] to \a dst_nd[dst], can overlap */
+static void
+evt_child_mbr_move(struct evt_context *tcx, struct evt_node *dst_nd, int dst,
+		   struct evt_node *src_nd, int src, int nr)
+{
+	memmove(&evt_child_mbr_lo(tcx, dst_nd)[dst],
+		&evt_child_mbr_lo(tcx, src_nd)[src], nr * sizeof(uint64_t));
+	memmove(&evt_child_mbr_hi(tcx, dst_nd)[dst],
+		&evt_child_mbr_hi(tcx, src_nd)[src], nr * sizeof(uint64_t));
+	memmove(&evt_child_mbr_epc(tcx, dst_nd)[dst],
+		&evt_child_mbr_epc(tcx, src_nd)[src], nr * sizeof(uint64_t));
+	memmove(&evt_child_mbr_minor(tcx, dst_nd)[dst],
+		&evt_child_mbr_minor(tcx, src_nd)[src], nr * sizeof(uint16_t));
+}
+
 void
 evt_node_rect_read_at(struct evt_context *tcx, struct evt_node *node,
 		      unsigned int at, struct evt_rect *rout)
@@ -1320,6 +1396,8 @@ evt_node_rect_read_at(struct evt_context *tcx, struct evt_node *node,
 	if (evt_node_is_leaf(tcx, node)) {
 		ne = evt_node_entry_at(tcx, node, at);
 		evt_rect_read(rout, &ne->ne_rect);
+	} else if (evt_node_has_child_mbr(tcx, node)) {
+		evt_child_mbr_read(tcx, node, at, rout);
 	} else {
 		child = evt_off2node(tcx, evt_node_child_at(tcx, node, at));
 		evt_mbr_read(rout, child);
@@ -1346,12 +1424,14 @@ evt_node_mbr_update(struct evt_context *tcx, struct evt_node *node,
 	struct evt_rect		 rout;
 	bool			 changed;
 
+	evt_mbr_read(&rin, child);
+	if (evt_node_has_child_mbr(tcx, node))
+		evt_child_mbr_write(tcx, node, at, &rin);
+
 	/* make adjustments to the position of the rectangle */
 	if (tcx->tc_ops->po_adjust)
 		tcx->tc_ops->po_adjust(tcx, node, at);
 
-	evt_mbr_read(&rin, child);
-
 	/* merge the rectangle with the current node */
 	evt_mbr_read(&rout, node);
 	changed = evt_rect_merge(&rout, &rin);
@@ -1362,6 +1442,17 @@ evt_node_mbr_update(struct evt_context *tcx, struct evt_node *node,
 	return changed;
 }
 
+/** Size of each child slot of an intermediate node */
+static inline size_t
+evt_child_size(uint64_t feats)
+{
+	if (feats & EVT_FEAT_CHILD_MBR)
+		return sizeof(uint64_t) + sizeof(struct evt_extent) +
+		       sizeof(daos_epoch_t) + sizeof(uint16_t);
+
+	return sizeof(uint64_t);
+}
+
 /**
  * Return the size of evtree node, leaf node has different size with internal
  * node.
@@ -1371,7 +1462,10 @@ evt_node_size(struct evt_context *tcx, bool leaf)
 {
 	size_t entry_size;
 
-	entry_size = leaf ? sizeof(struct evt_node_entry) : sizeof(uint64_t);
+	if (leaf)
+		entry_size = sizeof(struct evt_node_entry);
+	else
+		entry_size = evt_child_size(tcx->tc_feats);
 
 	return sizeof(struct evt_node) + entry_size * tcx->tc_order;
 }
@@ -1385,8 +1479,14 @@ evt_node_alloc(struct evt_context *tcx, unsigned int flags,
 	umem_off_t		 nd_off;
 	bool			 leaf = (flags & EVT_NODE_LEAF);
 
-	nd_off = vos_slab_alloc(evt_umm(tcx), evt_node_size(tcx, leaf),
-			leaf ? VOS_SLAB_EVT_NODE : VOS_SLAB_EVT_NODE_SM);
+	/* Intermediate nodes with child MBRs don't fit in the slab for small
+	 * nodes, they are rare enough to come from the generic allocator.
+	 */
+	if (!leaf && (tcx->tc_feats & EVT_FEAT_CHILD_MBR))
+		nd_off = umem_zalloc(evt_umm(tcx), evt_node_size(tcx, leaf));
+	else
+		nd_off = vos_slab_alloc(evt_umm(tcx), evt_node_size(tcx, leaf),
+				leaf ? VOS_SLAB_EVT_NODE : VOS_SLAB_EVT_NODE_SM);
 	if (UMOFF_IS_NULL(nd_off))
 		return -DER_NOSPACE;
 
@@ -2244,6 +2344,251 @@ out:
 	return rc == 0 ? alt_rc : rc;
 }
 
+static int
+evt_bulk_cmp(const void *p1, const void *p2)
+{
+	const struct evt_entry_in	*ent1 = *(const struct evt_entry_in **)p1;
+	const struct evt_entry_in	*ent2 = *(const struct evt_entry_in **)p2;
+
+	return evt_rect_cmp(&ent1->ei_rect, &ent2->ei_rect);
+}
+
+/** A subtree created by bulk loading */
+struct evt_bulk_child {
+	umem_off_t		bc_node;
+	struct evt_rect		bc_mbr;
+};
+
+/**
+ * Free a subtree created by a failed bulk load, it is only required by trees
+ * without transaction. Unlike evt_node_destroy(), data extents are owned by
+ * the caller and not freed.
+ */
+static void
+evt_bulk_free(struct evt_context *tcx, umem_off_t nd_off)
+{
+	struct evt_node_entry	*ne;
+	struct evt_node		*nd = evt_off2node(tcx, nd_off);
+	int			 i;
+
+	for (i = 0; i < nd->tn_nr; i++) {
+		if (!evt_node_is_leaf(tcx, nd)) {
+			evt_bulk_free(tcx, evt_node_child_at(tcx, nd, i));
+			continue;
+		}
+
+		ne = evt_node_entry_at(tcx, nd, i);
+		evt_desc_log_del(tcx, ne->ne_rect.rd_epc,
+				 evt_off2desc(tcx, ne->ne_child));
+		umem_free(evt_umm(tcx), ne->ne_child);
+	}
+	evt_node_free(tcx, nd_off);
+}
+
+/**
+ * Build the tree bottom-up from entries sorted by rectangle. Each level is
+ * split evenly to as few nodes as possible, entries and children are added
+ * by the insert method of the tree policy, so nodes are ordered as the policy
+ * expects, and MBRs are maintained by it as well.
+ */
+static int
+evt_bulk_build(struct evt_context *tcx, unsigned int nr,
+	       const struct evt_entry_in **ents)
+{
+	struct evt_root		*root = tcx->tc_root;
+	struct evt_bulk_child	*chd;	/* nodes of the lower level */
+	struct evt_bulk_child	*par;	/* nodes of the level being built */
+	struct evt_bulk_child	*tmp;
+	struct evt_entry_in	 ent_in;
+	struct evt_node		*nd;
+	umem_off_t		 nd_off = UMOFF_NULL;
+	unsigned int		 chd_nr = 0;
+	unsigned int		 par_nr = 0;
+	unsigned int		 next = 0; /* next child to add */
+	unsigned int		 nd_nr;
+	unsigned int		 cnt;
+	unsigned int		 flags;
+	unsigned int		 i;
+	unsigned int		 j;
+	int			 depth;
+	int			 rc;
+
+	nd_nr = (nr + tcx->tc_order - 1) / tcx->tc_order;
+	D_ALLOC_ARRAY(chd, nd_nr);
+	D_ALLOC_ARRAY(par, nd_nr);
+	if (chd == NULL || par == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0; i < nd_nr; i++) {
+		cnt = nr / nd_nr + (i < nr % nd_nr);
+		flags = EVT_NODE_LEAF | (nd_nr == 1 ? EVT_NODE_ROOT : 0);
+		rc = evt_node_alloc(tcx, flags, &nd_off);
+		if (rc != 0)
+			D_GOTO(failed, rc);
+
+		nd = evt_off2node(tcx, nd_off);
+		for (j = 0; j < cnt; j++) {
+			rc = evt_node_insert(tcx, nd, UMOFF_NULL, ents[next],
+					     NULL, NULL);
+			if (rc != 0)
+				D_GOTO(failed, rc);
+			next++;
+		}
+		par[par_nr].bc_node = nd_off;
+		evt_mbr_read(&par[par_nr].bc_mbr, nd);
+		par_nr++;
+		nd_off = UMOFF_NULL;
+	}
+
+	memset(&ent_in, 0, sizeof(ent_in));
+	for (depth = 1; par_nr > 1; depth++) {
+		tmp = chd;
+		chd = par;
+		par = tmp;
+		chd_nr = par_nr;
+		par_nr = 0;
+		next = 0;
+
+		nd_nr = (chd_nr + tcx->tc_order - 1) / tcx->tc_order;
+		for (i = 0; i < nd_nr; i++) {
+			cnt = chd_nr / nd_nr + (i < chd_nr % nd_nr);
+			flags = nd_nr == 1 ? EVT_NODE_ROOT : 0;
+			rc = evt_node_alloc(tcx, flags, &nd_off);
+			if (rc != 0)
+				D_GOTO(failed, rc);
+
+			nd = evt_off2node(tcx, nd_off);
+			for (j = 0; j < cnt; j++) {
+				ent_in.ei_rect = chd[next].bc_mbr;
+				rc = evt_node_insert(tcx, nd, chd[next].bc_node,
+						     &ent_in, NULL, NULL);
+				if (rc != 0)
+					D_GOTO(failed, rc);
+				next++;
+			}
+			par[par_nr].bc_node = nd_off;
+			evt_mbr_read(&par[par_nr].bc_mbr, nd);
+			par_nr++;
+			nd_off = UMOFF_NULL;
+		}
+	}
+
+	rc = evt_root_tx_add(tcx);
+	if (rc != 0)
+		D_GOTO(failed, rc);
+
+	root->tr_node = par[0].bc_node;
+	root->tr_depth = depth;
+	evt_tcx_set_dep(tcx, depth);
+	V_TRACE(DB_TRACE, "Bulk loaded %u entries, depth %d\n", nr, depth);
+	D_GOTO(out, rc = 0);
+failed:
+	if (!evt_has_tx(tcx)) {
+		/* the partial node owns the children added to it */
+		if (!UMOFF_IS_NULL(nd_off))
+			evt_bulk_free(tcx, nd_off);
+		for (i = 0; i < par_nr; i++)
+			evt_bulk_free(tcx, par[i].bc_node);
+		for (i = next; i < chd_nr; i++)
+			evt_bulk_free(tcx, chd[i].bc_node);
+	}
+out:
+	D_FREE(par);
+	D_FREE(chd);
+	return rc;
+}
+
+/**
+ * Load entries into an empty tree, see API comment in evtree.h.
+ */
+int
+evt_bulk_load(daos_handle_t toh, unsigned int nr,
+	      const struct evt_entry_in *entries)
+{
+	struct evt_context		 *tcx;
+	const struct evt_entry_in	**ents;
+	const struct evt_entry_in	 *csum_ent = NULL;
+	uint32_t			  inob = 0;
+	unsigned int			  i;
+	int				  rc;
+
+	tcx = evt_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (!evt_root_empty(tcx) || tcx->tc_depth != 0) {
+		D_ERROR("Can only bulk load an empty tree\n");
+		return -DER_INVAL;
+	}
+
+	if (nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(ents, nr);
+	if (ents == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < nr; i++) {
+		const struct evt_entry_in *ent = &entries[i];
+
+		D_ASSERT(evt_rect_width(&ent->ei_rect) != 0);
+		D_ASSERT(ent->ei_inob != 0 || bio_addr_is_hole(&ent->ei_addr));
+		if (evt_rect_width(&ent->ei_rect) > MAX_RECT_WIDTH) {
+			D_ERROR("Extent is too large\n");
+			D_GOTO(out, rc = -DER_NO_PERM);
+		}
+
+		if (ent->ei_inob != 0) {
+			if (inob != 0 && inob != ent->ei_inob) {
+				D_ERROR("Variable record size not supported in "
+					"evtree: %d != %d\n", ent->ei_inob,
+					inob);
+				D_GOTO(out, rc = -DER_INVAL);
+			}
+			inob = ent->ei_inob;
+		}
+
+		if (csum_ent == NULL && ci_is_valid(&ent->ei_csum))
+			csum_ent = ent;
+		ents[i] = ent;
+	}
+
+	qsort(ents, nr, sizeof(*ents), evt_bulk_cmp);
+	for (i = 1; i < nr; i++) {
+		if (evt_rect_cmp(&ents[i - 1]->ei_rect,
+				 &ents[i]->ei_rect) == 0) {
+			D_ERROR("Duplicate rectangle "DF_RECT"\n",
+				DP_RECT(&ents[i]->ei_rect));
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+	}
+
+	rc = evt_tx_begin(tcx);
+	if (rc != 0)
+		goto out;
+
+	/* Same as evt_root_activate(), but for all the entries */
+	rc = evt_root_tx_add(tcx);
+	if (rc != 0)
+		goto tx_end;
+
+	if (inob != 0)
+		tcx->tc_inob = tcx->tc_root->tr_inob = inob;
+	if (csum_ent != NULL) {
+		tcx->tc_root->tr_csum_len = csum_ent->ei_csum.cs_len;
+		tcx->tc_root->tr_csum_type = csum_ent->ei_csum.cs_type;
+		tcx->tc_root->tr_csum_chunk_size =
+			csum_ent->ei_csum.cs_chunksize;
+	}
+
+	rc = evt_bulk_build(tcx, nr, ents);
+tx_end:
+	rc = evt_tx_end(tcx, rc);
+out:
+	D_FREE(ents);
+	return rc;
+}
+
 /** Fill the entry with the extent at the specified position of \a node */
 void
 evt_entry_fill(struct evt_context *tcx, struct evt_node *node, unsigned int at,
@@ -2475,7 +2820,14 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 		struct evt_node		*node;
 		bool			 leaf;
 
-		node = evt_off2node(tcx, nd_off);
+		/* Intermediate nodes can be served from the DRAM node cache,
+		 * nothing in this loop modifies the node or yields.
+		 */
+		if (level < tcx->tc_depth - 1)
+			node = umem_node_cache_read(evt_umm(tcx), nd_off,
+						    evt_node_size(tcx, false));
+		else
+			node = evt_off2node(tcx, nd_off);
 		leaf = evt_node_is_leaf(tcx, node);
 
 		D_ASSERT(!leaf || at == 0);
@@ -3051,6 +3403,8 @@ evt_common_insert(struct evt_context *tcx, struct evt_node *nd,
 			nr = nd->tn_nr - i;
 			memmove(&nd->tn_child[i + 1], &nd->tn_child[i],
 				nr * sizeof(nd->tn_child[0]));
+			if (evt_node_has_child_mbr(tcx, nd))
+				evt_child_mbr_move(tcx, nd, i + 1, nd, i, nr);
 			break;
 		}
 
@@ -3143,6 +3497,8 @@ evt_common_insert(struct evt_context *tcx, struct evt_node *nd,
 		desc->dc_ver = ent->ei_ver;
 	} else {
 		nd->tn_child[i] = in_off;
+		if (evt_node_has_child_mbr(tcx, nd))
+			evt_child_mbr_write(tcx, nd, i, &ent->ei_rect);
 	}
 
 	if (!reuse)
@@ -3180,6 +3536,9 @@ evt_split_common(struct evt_context *tcx, bool leaf, struct evt_node *nd_src,
 	}
 
 	memcpy(entry_dst, entry_src, entry_size * (nd_src->tn_nr - idx));
+	if (!leaf && evt_node_has_child_mbr(tcx, nd_src))
+		evt_child_mbr_move(tcx, nd_dst, 0, nd_src, idx,
+				   nd_src->tn_nr - idx);
 	nd_dst->tn_nr = nd_src->tn_nr - idx;
 	nd_src->tn_nr = idx;
 }
@@ -3207,11 +3566,11 @@ static int
 evt_common_adjust(struct evt_context *tcx, struct evt_node *nd,
 		  int at, cmp_rect_cb cb)
 {
-	uint64_t		*dst_entry;
-	uint64_t		*src_entry;
 	uint64_t		 cached_entry;
 	struct evt_rect		 rtmp, rect;
 	int			 count;
+	int			 dst;
+	int			 src;
 	int			 i;
 	int			 offset;
 
@@ -3229,8 +3588,8 @@ evt_common_adjust(struct evt_context *tcx, struct evt_node *nd,
 	i++;
 	if (i != at) {
 		/* The entry needs to move left */
-		dst_entry = &nd->tn_child[i + 1];
-		src_entry = &nd->tn_child[i];
+		dst = i + 1;
+		src = i;
 		cached_entry = nd->tn_child[at];
 
 		count = at - i;
@@ -3248,8 +3607,8 @@ evt_common_adjust(struct evt_context *tcx, struct evt_node *nd,
 	i--;
 	if (i != at) {
 		/* the entry needs to move right */
-		dst_entry = &nd->tn_child[at];
-		src_entry = &nd->tn_child[at + 1];
+		dst = at;
+		src = at + 1;
 		cached_entry = nd->tn_child[at];
 		count = i - at;
 		offset = count;
@@ -3259,8 +3618,13 @@ evt_common_adjust(struct evt_context *tcx, struct evt_node *nd,
 	return 0;
 move:
 	/* Execute the move */
-	memmove(dst_entry, src_entry, sizeof(*dst_entry) * count);
+	memmove(&nd->tn_child[dst], &nd->tn_child[src],
+		sizeof(nd->tn_child[0]) * count);
 	nd->tn_child[i] = cached_entry;
+	if (evt_node_has_child_mbr(tcx, nd)) {
+		evt_child_mbr_move(tcx, nd, dst, nd, src, count);
+		evt_child_mbr_write(tcx, nd, i, &rect);
+	}
 
 	return offset;
 }
@@ -3540,6 +3904,9 @@ evt_node_delete(struct evt_context *tcx)
 			break;
 
 		memmove(data, data + child_size, child_size * count);
+		if (evt_node_has_child_mbr(tcx, node))
+			evt_child_mbr_move(tcx, node, trace->tr_at, node,
+					   trace->tr_at + 1, count);
 
 		break;
 	};
@@ -3580,6 +3947,9 @@ evt_node_delete(struct evt_context *tcx)
 			trace->tr_tx_added = true;
 		}
 
+		if (evt_node_has_child_mbr(tcx, node))
+			evt_child_mbr_write(tcx, node, trace->tr_at, &mbr);
+
 		/* make adjustments to the position of the rectangle */
 		if (!tcx->tc_ops->po_adjust)
 			continue;
@@ -3846,7 +4216,7 @@ evt_entry_csum_update(const struct evt_extent *const ext,
 }
 
 int
-evt_overhead_get(int alloc_overhead, int tree_order,
+evt_overhead_get(int alloc_overhead, uint64_t feats, int tree_order,
 		 struct daos_tree_overhead *ovhd)
 {
 	if (ovhd == NULL) {
@@ -3862,7 +4232,7 @@ evt_overhead_get(int alloc_overhead, int tree_order,
 		(tree_order * sizeof(struct evt_node_entry));
 	ovhd->to_leaf_overhead.no_order = tree_order;
 	ovhd->to_int_node_size = alloc_overhead + sizeof(struct evt_node) +
-		(tree_order * sizeof(uint64_t));
+		(tree_order * evt_child_size(feats));
 
 	return 0;
 }
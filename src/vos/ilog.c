@@ -83,6 +83,29 @@ struct ilog_context {
 	bool				 ic_ver_inc;
 };
 
+#define NUM_EMBEDDED 8
+
+/** The visibility cache is direct mapped on the log root offset */
+#define ILOG_VIS_CACHE_BITS	9
+#define ILOG_VIS_CACHE_SIZE	(1 << ILOG_VIS_CACHE_BITS)
+
+struct ilog_vis_ent {
+	/** umem offset of log root, UMOFF_NULL if the slot is unused */
+	umem_off_t		 ive_root_off;
+	/** umem offset of the entry array */
+	umem_off_t		 ive_array_off;
+	/** Version of the log when cached */
+	uint32_t		 ive_version;
+	/** Number of entries */
+	uint32_t		 ive_nr;
+	/** Copy of the entries, all of them persisted */
+	struct ilog_id		 ive_ids[NUM_EMBEDDED];
+};
+
+struct ilog_vis_cache {
+	struct ilog_vis_ent	 ivc_ents[ILOG_VIS_CACHE_SIZE];
+};
+
 D_CASSERT(sizeof(struct ilog_id) == sizeof(struct ilog_tree));
 D_CASSERT(sizeof(struct ilog_root) == sizeof(struct ilog_df));
 
@@ -179,6 +202,22 @@ ilog_init(void)
 	return 0;
 }
 
+int
+ilog_vis_cache_create(struct ilog_vis_cache **cache)
+{
+	D_ALLOC_PTR(*cache);
+	if (*cache == NULL)
+		return -DER_NOMEM;
+
+	return 0;
+}
+
+void
+ilog_vis_cache_destroy(struct ilog_vis_cache *cache)
+{
+	D_FREE(cache);
+}
+
 /* 4 bit magic number + version */
 #define ILOG_MAGIC		0x00000006
 #define ILOG_MAGIC_BITS		4
@@ -237,6 +276,29 @@ ilog_tx_begin(struct ilog_context *lctx)
 	return 0;
 }
 
+static inline struct ilog_vis_ent *
+ilog_vis_slot(struct ilog_vis_cache *cache, umem_off_t root_off)
+{
+	uint64_t	hash = root_off * 0x9E3779B97F4A7C15ULL;
+
+	return &cache->ivc_ents[hash >> (64 - ILOG_VIS_CACHE_BITS)];
+}
+
+/** Drop the cached copy of a log that is being modified */
+static inline void
+ilog_vis_evict(struct ilog_context *lctx)
+{
+	struct ilog_vis_cache	*cache = lctx->ic_cbs.dc_vis_cache;
+	struct ilog_vis_ent	*ent;
+
+	if (cache == NULL)
+		return;
+
+	ent = ilog_vis_slot(cache, lctx->ic_root_off);
+	if (ent->ive_root_off == lctx->ic_root_off)
+		ent->ive_root_off = UMOFF_NULL;
+}
+
 /** Only invokes transaction end if we've started a txn */
 static inline int
 ilog_tx_end(struct ilog_context *lctx, int rc)
@@ -244,6 +306,8 @@ ilog_tx_end(struct ilog_context *lctx, int rc)
 	if (!lctx->ic_in_txn)
 		return rc;
 
+	ilog_vis_evict(lctx);
+
 	if (rc != 0)
 		goto done;
 
@@ -520,7 +584,7 @@ ilog_root_migrate(struct ilog_context *lctx, const struct ilog_id *id_in)
 		return rc;
 	}
 
-	tree_root = umem_zalloc(&lctx->ic_umm, ILOG_ARRAY_CHUNK_SIZE);
+	tree_root = vos_slab_rec_alloc(&lctx->ic_umm, ILOG_ARRAY_CHUNK_SIZE);
 
 	if (tree_root == UMOFF_NULL)
 		return lctx->ic_umm.umm_nospc_rc;
@@ -813,7 +877,7 @@ insert:
 		new_len = (cache.ac_nr + 1) * 2 - 1;
 		new_size = sizeof(*cache.ac_array) + sizeof(cache.ac_entries[0]) * new_len;
 		D_ASSERT((new_size & (ILOG_ARRAY_CHUNK_SIZE - 1)) == 0);
-		new_array = umem_zalloc(&lctx->ic_umm, new_size);
+		new_array = vos_slab_rec_alloc(&lctx->ic_umm, new_size);
 		if (new_array == UMOFF_NULL)
 			return lctx->ic_umm.umm_nospc_rc;
 
@@ -1030,8 +1094,6 @@ ilog_abort(daos_handle_t loh, const struct ilog_id *id)
 	return ilog_modify(loh, id, &range, ILOG_OP_ABORT);
 }
 
-#define NUM_EMBEDDED 8
-
 struct ilog_priv {
 	/** Embedded context for current log root */
 	struct ilog_context	 ip_lctx;
@@ -1045,6 +1107,8 @@ struct ilog_priv {
 	int			 ip_rc;
 	/** Embedded status entries */
 	struct ilog_info	 ip_embedded[NUM_EMBEDDED];
+	/** Entries copied from the visibility cache */
+	struct ilog_id		 ip_ids[NUM_EMBEDDED];
 };
 D_CASSERT(sizeof(struct ilog_priv) <= ILOG_PRIV_SIZE);
 
@@ -1076,6 +1140,8 @@ ilog_fetch_move(struct ilog_entries *dest, struct ilog_entries *src)
 	/** We've already copied everything, just fix up any pointers here */
 	if (src->ie_info == &priv_src->ip_embedded[0])
 		dest->ie_info = &priv_dest->ip_embedded[0];
+	if (src->ie_ids == &priv_src->ip_ids[0])
+		dest->ie_ids = &priv_dest->ip_ids[0];
 
 	priv_src->ip_alloc_size = 0;
 }
@@ -1177,6 +1243,70 @@ done:
 	return 0;
 }
 
+/** Only read only fetches use the visibility cache.  Modifications fetch the
+ *  log inside their transaction and could otherwise cache state that is
+ *  rolled back on abort.
+ */
+static inline bool
+ilog_vis_intent(uint32_t intent)
+{
+	return intent != DAOS_INTENT_UPDATE && intent != DAOS_INTENT_PUNCH &&
+	       intent != DAOS_INTENT_PURGE;
+}
+
+static bool
+ilog_vis_lookup(struct ilog_context *lctx, uint32_t intent, struct ilog_entries *entries)
+{
+	struct ilog_priv	*priv = ilog_ent2priv(entries);
+	struct ilog_vis_cache	*cache = lctx->ic_cbs.dc_vis_cache;
+	struct ilog_root	*root = lctx->ic_root;
+	struct ilog_vis_ent	*ent;
+	int			 i;
+
+	if (cache == NULL || root->lr_tree.it_embedded || !ilog_vis_intent(intent))
+		return false;
+
+	ent = ilog_vis_slot(cache, lctx->ic_root_off);
+	if (ent->ive_root_off != lctx->ic_root_off ||
+	    ent->ive_array_off != root->lr_tree.it_root ||
+	    ent->ive_version != ilog_mag2ver(root->lr_magic))
+		return false;
+
+	memcpy(&priv->ip_ids[0], &ent->ive_ids[0], sizeof(ent->ive_ids[0]) * ent->ive_nr);
+	entries->ie_ids = &priv->ip_ids[0];
+	for (i = 0; i < ent->ive_nr; i++) {
+		entries->ie_info[i].ii_removed = 0;
+		entries->ie_info[i].ii_status = ILOG_COMMITTED;
+	}
+	entries->ie_num_entries = ent->ive_nr;
+
+	return true;
+}
+
+static void
+ilog_vis_insert(struct ilog_context *lctx, uint32_t intent, struct ilog_array_cache *cache)
+{
+	struct ilog_vis_cache	*vis_cache = lctx->ic_cbs.dc_vis_cache;
+	struct ilog_vis_ent	*ent;
+	int			 i;
+
+	if (vis_cache == NULL || cache->ac_array == NULL || cache->ac_nr > NUM_EMBEDDED ||
+	    !ilog_vis_intent(intent))
+		return;
+
+	for (i = 0; i < cache->ac_nr; i++) {
+		if (cache->ac_entries[i].id_tx_id != UMOFF_NULL)
+			return; /** Status depends on DTX state */
+	}
+
+	ent = ilog_vis_slot(vis_cache, lctx->ic_root_off);
+	ent->ive_root_off = lctx->ic_root_off;
+	ent->ive_array_off = lctx->ic_root->lr_tree.it_root;
+	ent->ive_version = ilog_mag2ver(lctx->ic_root->lr_magic);
+	ent->ive_nr = cache->ac_nr;
+	memcpy(&ent->ive_ids[0], cache->ac_entries, sizeof(ent->ive_ids[0]) * cache->ac_nr);
+}
+
 int
 ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 	   const struct ilog_desc_cbs *cbs, uint32_t intent,
@@ -1213,6 +1343,9 @@ ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 	if (ilog_empty(root))
 		D_GOTO(out, rc = 0);
 
+	if (ilog_vis_lookup(lctx, intent, entries))
+		D_GOTO(out, rc = 0);
+
 	ilog_log2cache(lctx, &cache);
 
 	rc = prepare_entries(entries, &cache);
@@ -1230,6 +1363,7 @@ ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 		entries->ie_info[entries->ie_num_entries++].ii_status = status;
 	}
 
+	ilog_vis_insert(lctx, intent, &cache);
 out:
 	D_ASSERT(rc != -DER_NONEXIST);
 	if (entries->ie_num_entries == 0)
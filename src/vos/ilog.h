@@ -34,6 +34,7 @@ struct  ilog_df {
 };
 
 struct umem_instance;
+struct ilog_vis_cache;
 
 enum ilog_status {
 	/** Log status is not set */
@@ -67,12 +68,33 @@ struct ilog_desc_cbs {
 			     uint32_t tx_id, daos_epoch_t epoch, bool abort,
 			     void *args);
 	void	*dc_log_del_args;
+	/** Optional DRAM cache of fully persisted logs */
+	struct ilog_vis_cache	*dc_vis_cache;
 };
 
 /** Globally initialize incarnation log */
 int
 ilog_init(void);
 
+/** Create a DRAM cache of incarnation logs whose entries are all persisted.
+ *  Fetching such a log for read skips decoding it from the pool.  The
+ *  cache is keyed by root offset and log version, so it should be shared
+ *  only by logs in the same pool.
+ *
+ *  \param	cache[OUT]	Returned cache
+ *
+ *  \return 0 on success, -DER_NOMEM on failure
+ */
+int
+ilog_vis_cache_create(struct ilog_vis_cache **cache);
+
+/** Destroy a cache created by ilog_vis_cache_create
+ *
+ *  \param	cache[IN]	The cache
+ */
+void
+ilog_vis_cache_destroy(struct ilog_vis_cache *cache);
+
 /** Create a new incarnation log in place
  *
  *  \param	umm[IN]		The umem instance
@@ -166,7 +188,7 @@ struct ilog_entry {
 	int32_t		ie_idx;
 };
 
-#define ILOG_PRIV_SIZE 408
+#define ILOG_PRIV_SIZE 544
 /* Information about ilog entries */
 struct ilog_info {
 	/** Status of ilog entry */
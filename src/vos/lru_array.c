@@ -84,7 +84,15 @@ lrua_array_alloc_one(struct lru_array *array, struct lru_sub *sub)
 
 	payload = sub->ls_payload = &sub->ls_table[nr_ents];
 	sub->ls_lru = LRU_NO_IDX;
+	if ((array->la_flags & LRU_FLAG_EVICT_MANUAL) == 0) {
+		/** Entries are initialized on demand, see sub_init_one */
+		sub->ls_free = LRU_NO_IDX;
+		sub->ls_nr_init = 0;
+		return 0;
+	}
+
 	sub->ls_free = 0;
+	sub->ls_nr_init = nr_ents;
 	for (idx = 0; idx < nr_ents; idx++) {
 		entry = &sub->ls_table[idx];
 		entry->le_payload = payload;
@@ -119,6 +127,7 @@ sub_find_free(struct lru_array *array, struct lru_sub *sub,
 	lrua_insert(sub, &sub->ls_lru, entry, tree_idx, true);
 
 	entry->le_key = key;
+	array->la_used++;
 
 	*entryp = entry;
 
@@ -127,6 +136,27 @@ sub_find_free(struct lru_array *array, struct lru_sub *sub,
 	return true;
 }
 
+/** Initialize the next unused entry of an array with automatic eviction and
+ *  add it to the free list.  Returns false if all entries are initialized.
+ */
+static inline bool
+sub_init_one(struct lru_array *array, struct lru_sub *sub)
+{
+	struct lru_entry	*entry;
+	uint32_t		 idx = sub->ls_nr_init;
+
+	if (idx > array->la_idx_mask)
+		return false;
+
+	entry = &sub->ls_table[idx];
+	entry->le_payload = (char *)sub->ls_payload + idx * array->la_payload_size;
+	init_cb(array, sub, entry, idx);
+	lrua_insert(sub, &sub->ls_free, entry, idx, false);
+	sub->ls_nr_init++;
+
+	return true;
+}
+
 static inline int
 manual_find_free(struct lru_array *array, struct lru_entry **entryp,
 		 uint32_t *idx, uint64_t key)
@@ -177,14 +207,19 @@ lrua_find_free(struct lru_array *array, struct lru_entry **entryp,
 	}
 
 	sub = &array->la_sub[0];
-	if (sub_find_free(array, sub, entryp, idx, key))
-		return 0;
+	if (array->la_used < array->la_limit) {
+		if (sub->ls_free == LRU_NO_IDX)
+			sub_init_one(array, sub);
+		if (sub_find_free(array, sub, entryp, idx, key))
+			return 0;
+	}
 
 	entry = &sub->ls_table[sub->ls_lru];
 	/** Key should not be 0, otherwise, it should be in free list */
 	D_ASSERT(entry->le_key != 0);
 
 	evict_cb(array, sub, entry, sub->ls_lru);
+	array->la_evicted++;
 
 	*idx = ent2idx(array, sub, sub->ls_lru);
 	entry->le_key = key;
@@ -221,6 +256,7 @@ lrua_evictx(struct lru_array *array, uint32_t idx, uint64_t key)
 	evict_cb(array, sub, entry, ent_idx);
 
 	entry->le_key = 0;
+	array->la_used--;
 
 	/** Remove from active list */
 	lrua_remove_entry(sub, &sub->ls_lru, entry, ent_idx);
@@ -278,6 +314,7 @@ lrua_array_alloc(struct lru_array **arrayp, uint32_t nr_ent, uint32_t nr_arrays,
 		return -DER_NOMEM;
 
 	array->la_count = nr_ent;
+	array->la_limit = nr_ent;
 	array->la_idx_mask = (nr_ent / nr_arrays) - 1;
 	array->la_array_nr = nr_arrays;
 	array->la_array_shift = 1;
@@ -314,7 +351,7 @@ array_free_one(struct lru_array *array, struct lru_sub *sub)
 {
 	uint32_t	idx;
 
-	for (idx = 0; idx < array->la_idx_mask + 1; idx++)
+	for (idx = 0; idx < sub->ls_nr_init; idx++)
 		fini_cb(array, sub, &sub->ls_table[idx], idx);
 
 	D_FREE(sub->ls_table);
@@ -339,6 +376,15 @@ lrua_array_free(struct lru_array *array)
 	D_FREE(array);
 }
 
+void
+lrua_array_set_limit(struct lru_array *array, uint32_t limit)
+{
+	if (array->la_flags & LRU_FLAG_EVICT_MANUAL)
+		return; /* Not applicable */
+
+	array->la_limit = min(max(limit, 3), array->la_count);
+}
+
 void
 lrua_array_aggregate(struct lru_array *array)
 {
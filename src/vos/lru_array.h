@@ -42,8 +42,10 @@ struct lru_sub {
 	uint32_t		 ls_free;
 	/** Index of this entry in the array */
 	uint32_t		 ls_array_idx;
-	/** Padding */
-	uint32_t		 ls_pad;
+	/** Number of initialized entries.  Arrays with automatic eviction
+	 *  initialize entries on demand, as the limit allows.
+	 */
+	uint32_t		 ls_nr_init;
 	/** Link in the array free/unused list.  If the subarray has no free
 	 *  entries, it is removed from either list so this field is unused.
 	 */
@@ -82,6 +84,14 @@ struct lru_array {
 	uint32_t		 la_array_shift;
 	/** First level mask */
 	uint32_t		 la_idx_mask;
+	/** Soft limit on entries in use before the LRU is evicted.  Only
+	 *  applies to arrays with automatic eviction.
+	 */
+	uint32_t		 la_limit;
+	/** Number of entries in use */
+	uint32_t		 la_used;
+	/** Number of entries evicted to make room for new ones */
+	uint64_t		 la_evicted;
 	/** Subarrays with free entries */
 	d_list_t		 la_free_sub;
 	/** Unallocated subarrays */
@@ -420,6 +430,8 @@ lrua_allocx_inplace_(struct lru_array *array, uint32_t idx, uint64_t key,
 		return -DER_NO_PERM;
 	}
 
+	if (entry->le_key == 0)
+		array->la_used++;
 	entry->le_key = key;
 
 	/** First remove */
@@ -479,6 +491,19 @@ lrua_array_alloc(struct lru_array **array, uint32_t nr_ent, uint32_t nr_arrays,
 void
 lrua_array_free(struct lru_array *array);
 
+/** Change the number of entries an LRU array with automatic eviction keeps
+ *  in use before it starts evicting the LRU.  Entries are only initialized
+ *  when first used, so the memory backing entries above the limit is not
+ *  touched until the limit grows.  Shrinking the limit doesn't evict
+ *  anything, entries above the limit are recycled as new entries are
+ *  allocated.
+ *
+ * \param	array[in]	The LRU array
+ * \param	limit[in]	New limit, clamped to [3, number of entries]
+ */
+void
+lrua_array_set_limit(struct lru_array *array, uint32_t limit);
+
 /** Aggregate the LRU array
  *
  * Frees up extraneous unused subarrays.   Only applies to arrays with more
@@ -2305,6 +2305,153 @@ test_evt_outer_punch(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+static int
+evt_iter_count(daos_handle_t toh, int options)
+{
+	daos_handle_t	ih;
+	int		count = 0;
+	int		rc;
+
+	rc = evt_iter_prepare(toh, options, NULL, &ih);
+	assert_rc_equal(rc, 0);
+
+	rc = evt_iter_probe(ih, EVT_ITER_FIRST, NULL, NULL);
+	while (rc == 0) {
+		count++;
+		rc = evt_iter_next(ih);
+	}
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	rc = evt_iter_finish(ih);
+	assert_rc_equal(rc, 0);
+	return count;
+}
+
+static void
+test_evt_bulk_load_internal(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct evt_entry_in	*entries;
+	struct evt_entry_in	*entry;
+	daos_handle_t		 toh;
+	int			 nr = NUM_EPOCHS * NUM_EXTENTS;
+	int			 epoch;
+	int			 offset;
+	int			 rc;
+
+	D_ALLOC_ARRAY(entries, nr);
+	assert_non_null(entries);
+
+	rc = evt_create(arg->ta_root, ts_feats, ORDER_DEF_INTERNAL, arg->ta_uma,
+			&ts_evt_desc_cbs, &toh);
+	assert_rc_equal(rc, 0);
+
+	/* Entries are loaded in the reverse order of the epoch */
+	entry = entries;
+	for (epoch = NUM_EPOCHS; epoch > 0; epoch--) {
+		for (offset = epoch; offset < NUM_EXTENTS + epoch; offset++) {
+			entry->ei_rect.rc_ex.ex_lo = offset;
+			entry->ei_rect.rc_ex.ex_hi = offset;
+			entry->ei_rect.rc_epc = epoch;
+			entry->ei_bound = epoch;
+			entry->ei_inob = sizeof(offset);
+			rc = bio_alloc_init(arg->ta_utx, &entry->ei_addr,
+					    &offset, sizeof(offset));
+			assert_int_equal(rc, 0);
+			entry++;
+		}
+	}
+
+	rc = evt_bulk_load(toh, nr, entries);
+	assert_rc_equal(rc, 0);
+
+	assert_int_equal(evt_iter_count(toh, EVT_ITER_EMBEDDED), nr);
+	assert_int_equal(evt_iter_count(toh, EVT_ITER_VISIBLE),
+			 NUM_EPOCHS + NUM_EXTENTS - 1);
+
+	/* Only an empty tree can be bulk loaded */
+	rc = evt_bulk_load(toh, nr, entries);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = evt_destroy(toh);
+	assert_rc_equal(rc, 0);
+	D_FREE(entries);
+}
+
+static void
+test_evt_overhead_child_mbr_internal(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct daos_tree_overhead ovhd;
+	struct daos_tree_overhead ovhd_def;
+	daos_handle_t		 toh;
+	struct evt_entry_in	 entry = {0};
+	struct evt_node		*node;
+	struct evt_node		*child;
+	uint64_t		 feats = ts_feats | EVT_FEAT_CHILD_MBR;
+	uint64_t		*lo;
+	uint64_t		*hi;
+	daos_epoch_t		*epc;
+	uint16_t		*minor;
+	char			 testdata[] = "deadbeef";
+	int			 order = ORDER_DEF_INTERNAL;
+	int			 rc;
+	int			 i;
+
+	rc = evt_overhead_get(0, ts_feats, order, &ovhd_def);
+	assert_rc_equal(rc, 0);
+	rc = evt_overhead_get(0, feats, order, &ovhd);
+	assert_rc_equal(rc, 0);
+	assert_true(ovhd.to_int_node_size > ovhd_def.to_int_node_size);
+	assert_int_equal(ovhd.to_leaf_overhead.no_size,
+			 ovhd_def.to_leaf_overhead.no_size);
+
+	rc = evt_create(arg->ta_root, feats, order, arg->ta_uma,
+			&ts_evt_desc_cbs, &toh);
+	assert_rc_equal(rc, 0);
+
+	/* Enough records for an intermediate root node */
+	for (i = 0; i < order * 4; i++) {
+		entry.ei_rect.rc_ex.ex_lo = i * sizeof(testdata);
+		entry.ei_rect.rc_ex.ex_hi = (i + 1) * sizeof(testdata) - 1;
+		entry.ei_rect.rc_epc = i + 1;
+		entry.ei_rect.rc_minor_epc = i + 1;
+		entry.ei_bound = i + 1;
+		entry.ei_ver = 0;
+		entry.ei_inob = 1;
+		memset(&entry.ei_csum, 0, sizeof(entry.ei_csum));
+		rc = bio_alloc_init(arg->ta_utx, &entry.ei_addr, testdata,
+				    sizeof(testdata));
+		assert_int_equal(rc, 0);
+		rc = evt_insert(toh, &entry, NULL);
+		if (rc == 1)
+			rc = 0;
+		assert_rc_equal(rc, 0);
+	}
+	assert_true(arg->ta_root->tr_depth > 1);
+
+	/* The child MBR arrays fill the intermediate node up to the estimated
+	 * size, the last array ends exactly there.
+	 */
+	node = utest_off2ptr(arg->ta_utx, arg->ta_root->tr_node);
+	minor = (uint16_t *)((char *)node + ovhd.to_int_node_size) - order;
+	epc = (daos_epoch_t *)minor - order;
+	hi = (uint64_t *)epc - order;
+	lo = hi - order;
+	assert_ptr_equal(lo, &node->tn_child[order]);
+
+	for (i = 0; i < node->tn_nr; i++) {
+		child = utest_off2ptr(arg->ta_utx, node->tn_child[i]);
+		assert_int_equal(lo[i], child->tn_mbr_ex.ex_lo);
+		assert_int_equal(hi[i], child->tn_mbr_ex.ex_hi);
+		assert_int_equal(epc[i], child->tn_mbr_epc);
+		assert_int_equal(minor[i], child->tn_mbr_minor_epc);
+	}
+
+	rc = evt_destroy(toh);
+	assert_rc_equal(rc, 0);
+}
+
 static int
 run_internal_tests(char *test_name)
 {
@@ -2344,6 +2491,12 @@ run_internal_tests(char *test_name)
 		{ "EVT020: evt_agg_check",
 			test_evt_agg_check,
 			setup_builtin, teardown_builtin},
+		{ "EVT021: evt_bulk_load_internal",
+			test_evt_bulk_load_internal,
+			setup_builtin, teardown_builtin},
+		{ "EVT022: evt_overhead_child_mbr_internal",
+			test_evt_overhead_child_mbr_internal,
+			setup_builtin, teardown_builtin},
 		{ NULL, NULL, NULL, NULL }
 	};
 
@@ -2424,6 +2577,8 @@ ts_cmd_run(char opc, char *args)
 			ts_feats = EVT_FEAT_SORT_SOFF;
 		else if (strcasecmp(args, "dist_even") == 0)
 			ts_feats = EVT_FEAT_SORT_DIST_EVEN;
+		else if (strcasecmp(args, "child_mbr") == 0)
+			ts_feats |= EVT_FEAT_CHILD_MBR;
 		break;
 	default:
 		D_PRINT("Unsupported command %c\n", opc);
@@ -2859,6 +2859,136 @@ aggregate_35(void **state)
 	assert_int_equal(feats & INIT_FEATS, INIT_FEATS);
 }
 
+static int
+dirty_recs_nr(struct io_test_args *arg, daos_unit_oid_t oid, char *dkey, char *akey)
+{
+	daos_epoch_range_t	epr = {0, DAOS_EPOCH_MAX};
+
+	return phy_recs_nr(arg, oid, &epr, dkey, akey, DAOS_IOD_SINGLE);
+}
+
+/*
+ * Aggregate with HLC epochs, the dirty object set is used once HAE passed
+ * the bound set on container open, and dropped on overflow.
+ */
+static void
+aggregate_36(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct vos_container	*cont = vos_hdl2cont(arg->ctx.tc_co_hdl);
+	daos_unit_oid_t		 oid_a, oid_b, oid;
+	char			 dkey[UPDATE_DKEY_SIZE] = { 0 };
+	char			 akey[UPDATE_AKEY_SIZE] = { 0 };
+	daos_recx_t		 recx = { 0 };
+	daos_epoch_range_t	 epr;
+	daos_epoch_t		 epoch, hae;
+	char			 buf_u[16], buf_f[16];
+	uint32_t		 count;
+	bool			 valid;
+	int			 i, rc;
+
+	arg->ta_flags = TF_USE_VAL;
+	oid_a = dts_unit_oid_gen(0, 0);
+	oid_b = dts_unit_oid_gen(0, 0);
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+
+	/* Two versions per object, below the bound of dirty object set */
+	epoch = crt_hlc_get();
+	for (i = 0; i < 2; i++) {
+		memset(buf_u, 'a' + i, sizeof(buf_u));
+		update_value(arg, oid_a, epoch + i, 0, dkey, akey, DAOS_IOD_SINGLE,
+			     sizeof(buf_u), &recx, buf_u);
+		update_value(arg, oid_b, epoch + i, 0, dkey, akey, DAOS_IOD_SINGLE,
+			     sizeof(buf_u), &recx, buf_u);
+	}
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_false(valid);
+
+	/* Full scan, move HAE past the bound, versions below epr_lo are kept */
+	epr.epr_lo = epoch + 2;
+	epr.epr_hi = crt_hlc_get() + crt_hlc_epsilon_get();
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, 0);
+	assert_rc_equal(rc, 0);
+	hae = epr.epr_hi;
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_true(valid);
+	assert_int_equal(count, 0);
+	assert_int_equal(dirty_recs_nr(arg, oid_a, dkey, akey), 2);
+	assert_int_equal(dirty_recs_nr(arg, oid_b, dkey, akey), 2);
+
+	/* Only touch oid_a, aggregation visits the dirty object set only */
+	for (i = 0; i < 2; i++) {
+		memset(buf_u, 'c' + i, sizeof(buf_u));
+		update_value(arg, oid_a, hae + 1 + i, 0, dkey, akey, DAOS_IOD_SINGLE,
+			     sizeof(buf_u), &recx, buf_u);
+	}
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_true(valid);
+	assert_int_equal(count, 1);
+
+	epr.epr_lo = 0;
+	epr.epr_hi = hae + 3;
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, 0);
+	assert_rc_equal(rc, 0);
+	hae = epr.epr_hi;
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_true(valid);
+	assert_int_equal(count, 0);
+	assert_int_equal(dirty_recs_nr(arg, oid_a, dkey, akey), 1);
+	assert_int_equal(dirty_recs_nr(arg, oid_b, dkey, akey), 2);
+
+	fetch_value(arg, oid_a, hae, 0, dkey, akey, DAOS_IOD_SINGLE, sizeof(buf_f), &recx, buf_f);
+	assert_memory_equal(buf_u, buf_f, sizeof(buf_f));
+	memset(buf_u, 'b', sizeof(buf_u));
+	fetch_value(arg, oid_b, hae, 0, dkey, akey, DAOS_IOD_SINGLE, sizeof(buf_f), &recx, buf_f);
+	assert_memory_equal(buf_u, buf_f, sizeof(buf_f));
+
+	/* Touch oid_b, then overflow the dirty object set */
+	for (i = 0; i < 2; i++) {
+		memset(buf_u, 'e' + i, sizeof(buf_u));
+		update_value(arg, oid_b, hae + 1 + i, 0, dkey, akey, DAOS_IOD_SINGLE,
+			     sizeof(buf_u), &recx, buf_u);
+	}
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_true(valid);
+	assert_int_equal(count, 1);
+
+	memset(&oid, 0, sizeof(oid));
+	oid.id_shard = 1;
+	for (i = 0; i < AGG_DIRTY_MAX; i++) {
+		oid.id_pub.lo = i;
+		vos_agg_dirty_add(cont, oid, hae + 2);
+	}
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_false(valid);
+	assert_int_equal(count, 0);
+
+	/* Fall back to full scan, oid_b is aggregated though not tracked */
+	epr.epr_lo = 0;
+	epr.epr_hi = hae + 3;
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, 0);
+	assert_rc_equal(rc, 0);
+	hae = epr.epr_hi;
+
+	valid = vos_agg_dirty_query(cont, &count);
+	assert_true(valid);
+	assert_int_equal(count, 0);
+	assert_int_equal(dirty_recs_nr(arg, oid_b, dkey, akey), 1);
+
+	fetch_value(arg, oid_b, hae, 0, dkey, akey, DAOS_IOD_SINGLE, sizeof(buf_f), &recx, buf_f);
+	assert_memory_equal(buf_u, buf_f, sizeof(buf_f));
+
+	arg->ta_flags = 0;
+	cleanup();
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -2975,6 +3105,8 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_34, NULL, agg_tst_teardown },
 	{ "VOS435: Test aggregation timestamp functions",
 	  aggregate_35, NULL, NULL },
+	{ "VOS436: Aggregate dirty objects only",
+	  aggregate_36, NULL, agg_tst_teardown },
 };
 
 int
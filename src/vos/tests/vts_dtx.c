@@ -854,6 +854,80 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+#define DTX_19_CNT	9000
+
+/* Lookup committed and non-committed DTXs after the committed DTX bloom filter enlarged. */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct dtx_id			*xid;
+	struct dtx_id			 other;
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_REC_SIZE];
+	int				 rc;
+	int				 i;
+
+	D_ALLOC_ARRAY(xid, DTX_19_CNT);
+	assert_non_null(xid);
+
+	for (i = 0; i < DTX_19_CNT; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_REC_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+
+		xid[i] = dth->dth_xid;
+
+		vts_dtx_end(dth);
+	}
+
+	for (i = 0; i < DTX_19_CNT; i += DTX_THRESHOLD_COUNT) {
+		int	cnt = min(DTX_19_CNT - i, DTX_THRESHOLD_COUNT);
+
+		rc = vos_dtx_commit(args->ctx.tc_co_hdl, &xid[i], cnt, NULL);
+		assert_rc_equal(rc, cnt);
+	}
+
+	/* Enlarge the filter step by step. */
+	do {
+		rc = vos_dtx_cmt_bloom_grow(args->ctx.tc_co_hdl);
+		assert_true(rc >= 0);
+	} while (rc > 0);
+
+	for (i = 0; i < DTX_19_CNT; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, NULL);
+		assert_rc_equal(rc, DTX_ST_COMMITTED);
+	}
+
+	for (i = 0; i < 100; i++) {
+		daos_dti_gen_unique(&other);
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &other, NULL, NULL, NULL, NULL);
+		assert_rc_equal(rc, -DER_NONEXIST);
+	}
+
+	D_FREE(xid);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -888,6 +962,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: DTX lookup with enlarged committed DTX filter",
+	  dtx_19, NULL, dtx_tst_teardown },
 };
 
 int
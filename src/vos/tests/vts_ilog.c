@@ -1046,6 +1046,73 @@ ilog_test_discard(void **state)
 	ilog_fetch_finish(&ilents);
 }
 
+static void
+ilog_test_vis_cache(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_pool		*pool;
+	struct umem_instance	*umm;
+	struct ilog_df		*ilog;
+	struct entries		*entries = args->custom;
+	struct ilog_desc_cbs	 cbs = ilog_callbacks;
+	struct ilog_id		 saved_ids[4];
+	daos_handle_t		 loh;
+	int			 i;
+	int			 rc;
+
+	assert_non_null(entries);
+	pool = vos_hdl2pool(args->ctx.tc_po_hdl);
+	assert_non_null(pool);
+	umm = vos_pool2umm(pool);
+
+	rc = ilog_vis_cache_create(&cbs.dc_vis_cache);
+	assert_rc_equal(rc, 0);
+
+	ilog = ilog_alloc_root(umm);
+
+	rc = ilog_create(umm, ilog);
+	LOG_FAIL(rc, 0, "Failed to create a new incarnation log\n");
+
+	rc = ilog_open(umm, ilog, &cbs, &loh);
+	LOG_FAIL(rc, 0, "Failed to open incarnation log\n");
+
+	current_status = PREPARED;
+	for (i = 0; i < 4; i++) {
+		rc = ilog_update(loh, NULL, i + 1, 1, i == 3);
+		LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+		saved_ids[i] = current_tx_id;
+	}
+
+	for (i = 0; i < 4; i++) {
+		rc = ilog_persist(loh, &saved_ids[i]);
+		LOG_FAIL(rc, 0, "Failed to persist log entry\n");
+	}
+
+	/** The first fetch caches the persisted log, the second uses it */
+	rc = entries_set(entries, ENTRY_NEW, 1, false, 2, false, 3, false,
+			 4, true, ENTRIES_END);
+	assert_rc_equal(rc, 0);
+	rc = entries_check(umm, ilog, &cbs, NULL, 0, entries);
+	assert_rc_equal(rc, 0);
+	rc = entries_check(umm, ilog, &cbs, NULL, 0, entries);
+	assert_rc_equal(rc, 0);
+
+	/** Modifying the log invalidates the cached copy */
+	rc = ilog_update(loh, NULL, 5, 1, true);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	rc = entries_set(entries, ENTRY_APPEND, 5, true, ENTRIES_END);
+	assert_rc_equal(rc, 0);
+	rc = entries_check(umm, ilog, &cbs, NULL, 0, entries);
+	assert_rc_equal(rc, 0);
+
+	ilog_close(loh);
+	rc = ilog_destroy(umm, &cbs, ilog);
+	assert_rc_equal(rc, 0);
+	assert_true(d_list_empty(&fake_tx_list));
+	ilog_free_root(umm, ilog);
+	ilog_vis_cache_destroy(cbs.dc_vis_cache);
+}
+
 static const struct CMUnitTest inc_tests[] = {
 	{ "VOS500.1: VOS incarnation log UPDATE", ilog_test_update, NULL,
 		NULL},
@@ -1057,6 +1124,8 @@ static const struct CMUnitTest inc_tests[] = {
 		NULL, NULL},
 	{ "VOS500.5: VOS incarnation log DISCARD test", ilog_test_discard,
 		NULL, NULL},
+	{ "VOS500.6: VOS incarnation log visibility cache test",
+		ilog_test_vis_cache, NULL, NULL},
 };
 
 int
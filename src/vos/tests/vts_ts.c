@@ -662,6 +662,57 @@ lru_array_multi_test(void **state)
 	lru_array_multi_test_iter(state);
 }
 
+static void
+lru_array_limit_test(void **state)
+{
+	struct lru_arg		*ts_arg = *state;
+	struct lru_record	*entry;
+	uint32_t		 limit = LRU_ARRAY_SIZE / 4;
+	int			 i;
+	bool			 found;
+	int			 rc;
+
+	lrua_array_set_limit(ts_arg->array, limit);
+	assert_int_equal(ts_arg->array->la_limit, limit);
+
+	for (i = 0; i < LRU_ARRAY_SIZE; i++) {
+		rc = lrua_alloc(ts_arg->array, &ts_arg->indexes[i].idx, &entry);
+		assert_rc_equal(rc, 0);
+		assert_non_null(entry);
+
+		entry->record = &ts_arg->indexes[i];
+		ts_arg->indexes[i].value = i;
+	}
+
+	/** Only the last limit entries should be cached, entries above the
+	 *  limit are never initialized
+	 */
+	assert_int_equal(ts_arg->array->la_used, limit);
+	assert_int_equal(ts_arg->array->la_sub[0].ls_nr_init, limit);
+	assert_int_equal(ts_arg->array->la_evicted, LRU_ARRAY_SIZE - limit);
+	for (i = 0; i < LRU_ARRAY_SIZE; i++) {
+		found = lrua_lookup(ts_arg->array, &ts_arg->indexes[i].idx,
+				    &entry);
+		assert_true(found == (i >= LRU_ARRAY_SIZE - limit));
+	}
+
+	/** Growing the limit uses free entries before evicting */
+	lrua_array_set_limit(ts_arg->array, LRU_ARRAY_SIZE);
+	for (i = 0; i < LRU_ARRAY_SIZE - limit; i++) {
+		rc = lrua_alloc(ts_arg->array, &ts_arg->indexes[i].idx, &entry);
+		assert_rc_equal(rc, 0);
+		entry->record = &ts_arg->indexes[i];
+		ts_arg->indexes[i].value = i;
+	}
+	assert_int_equal(ts_arg->array->la_used, LRU_ARRAY_SIZE);
+	assert_int_equal(ts_arg->array->la_sub[0].ls_nr_init, LRU_ARRAY_SIZE);
+	assert_int_equal(ts_arg->array->la_evicted, LRU_ARRAY_SIZE - limit);
+
+	/** Limit is clamped to the array size */
+	lrua_array_set_limit(ts_arg->array, LRU_ARRAY_SIZE * 2);
+	assert_int_equal(ts_arg->array->la_limit, LRU_ARRAY_SIZE);
+}
+
 static int
 init_lru_test(void **state)
 {
@@ -774,6 +825,8 @@ static const struct CMUnitTest ts_tests[] = {
 		init_lru_multi_test, finalize_lru_test},
 	{ "VOS600.4: VOS timestamp allocation test", ilog_test_ts_get,
 		ts_test_init, ts_test_fini},
+	{ "VOS600.5: LRU array limit test", lru_array_limit_test, init_lru_test,
+		finalize_lru_test},
 };
 
 int
@@ -16,6 +16,7 @@
 #include "vos_policy.h"
 
 unsigned int vos_agg_nvme_thresh = VOS_MW_NVME_THRESH;
+unsigned int vos_agg_ults = 1;
 
 /*
  * EV tree sorted iterator returns logical entry in extent start order, and
@@ -151,8 +152,38 @@ struct vos_agg_credits {
 	uint32_t	vac_creds_merge;	/* # of merging operations */
 };
 
+/*
+ * State shared by the ULTs aggregating one container in parallel. Each ULT
+ * scans a disjoint partition (by OID hash) of the object index, all of them
+ * consume the same credits, and only the ULT which started the aggregation
+ * calls the yield function, since the yield function could be bound to it.
+ */
+struct vos_agg_shared {
+	struct vos_agg_credits	 as_credits;
+	ABT_mutex		 as_mutex;
+	ABT_cond		 as_cond;
+	/* Bumped on each yield done on behalf of the workers */
+	uint64_t		 as_gen;
+	/* # of partitions */
+	uint32_t		 as_nr;
+	/* # of workers not finished yet */
+	uint32_t		 as_running;
+	/* Some worker exhausted the credits and is waiting for a yield */
+	bool			 as_yield_req;
+	/* Aborted by the yield function or by a worker failure */
+	bool			 as_abort;
+};
+
 struct vos_agg_param {
 	struct vos_agg_credits	ap_credits;
+	/* Shared state for parallel aggregation, NULL for single ULT */
+	struct vos_agg_shared	*ap_shared;
+	/* Partition index for parallel aggregation */
+	uint32_t		ap_part;
+	/* Dirty object being aggregated by incremental aggregation */
+	daos_unit_oid_t		*ap_dirty_oid;
+	/* Iterator moved past the dirty object */
+	bool			ap_dirty_done;
 	daos_handle_t		ap_coh;		/* container handle */
 	daos_unit_oid_t		ap_oid;		/* current object ID */
 	/* Boundary for aggregatable write filter */
@@ -211,6 +242,15 @@ credits_exhausted(struct vos_agg_credits *vac)
 	return !vac->vac_creds_scan || !vac->vac_creds_del || !vac->vac_creds_merge;
 }
 
+static inline struct vos_agg_credits *
+agg_credits(struct vos_agg_param *agg_param)
+{
+	if (agg_param->ap_shared != NULL)
+		return &agg_param->ap_shared->as_credits;
+
+	return &agg_param->ap_credits;
+}
+
 static inline struct vos_agg_metrics *
 agg_cont2metrics(struct vos_container *cont)
 {
@@ -253,7 +293,7 @@ agg_del_sv(daos_handle_t ih, struct vos_agg_param *agg_param,
 	*acts |= VOS_ITER_CB_DELETE;
 	if (vam && vam->vam_del_sv && !agg_param->ap_discard)
 		d_tm_inc_counter(vam->vam_del_sv, 1);
-	credits_consume(&agg_param->ap_credits, AGG_OP_DEL);
+	credits_consume(agg_credits(agg_param), AGG_OP_DEL);
 
 	return rc;
 }
@@ -265,7 +305,7 @@ inc_agg_counter(struct vos_agg_param *agg_param, vos_iter_type_t type, unsigned
 	struct vos_agg_metrics	*vam = agg_cont2metrics(cont);
 	struct d_tm_node_t	*counter = NULL;
 
-	credits_consume(&agg_param->ap_credits, agg_op);
+	credits_consume(agg_credits(agg_param), agg_op);
 
 	if (vam == NULL)
 		return;
@@ -310,37 +350,100 @@ need_aggregate(daos_handle_t ih, struct vos_agg_param *agg_param, vos_iter_desc_
 	return agg_needed;
 }
 
-static inline bool
-vos_aggregate_yield(struct vos_agg_param *agg_param)
+/* Returns true when aggregation needs be aborted */
+static bool
+agg_yield(int (*yield_func)(void *arg), void *yield_arg, struct vos_agg_credits *vac)
 {
 	int	rc;
 
-	/* Current DTX handle must be NULL, since aggregation runs under non-DTX mode. */
-	D_ASSERT(vos_dth_get() == NULL);
-
-	if (agg_param->ap_yield_func == NULL) {
+	if (yield_func == NULL) {
 		bio_yield();
-		credits_set(&agg_param->ap_credits, true);
+		credits_set(vac, true);
 		return false;
 	}
 
-	rc = agg_param->ap_yield_func(agg_param->ap_yield_arg);
+	rc = yield_func(yield_arg);
 	/* Abort */
 	if (rc < 0)
 		return true;
 
 	/* rc == 0: tight mode; rc == 1: slack mode */
-	credits_set(&agg_param->ap_credits, rc == 0);
+	credits_set(vac, rc == 0);
 
 	return false;
 }
 
+/* Wait for the ULT started the aggregation to yield on behalf of the workers */
+static bool
+agg_shared_yield(struct vos_agg_shared *as)
+{
+	uint64_t	gen;
+	bool		abort;
+
+	ABT_mutex_lock(as->as_mutex);
+	if (!as->as_abort) {
+		gen = as->as_gen;
+		as->as_yield_req = true;
+		ABT_cond_broadcast(as->as_cond);
+		while (gen == as->as_gen && !as->as_abort)
+			ABT_cond_wait(as->as_cond, as->as_mutex);
+	}
+	abort = as->as_abort;
+	ABT_mutex_unlock(as->as_mutex);
+
+	return abort;
+}
+
+static inline bool
+vos_aggregate_yield(struct vos_agg_param *agg_param)
+{
+	/* Current DTX handle must be NULL, since aggregation runs under non-DTX mode. */
+	D_ASSERT(vos_dth_get() == NULL);
+
+	if (agg_param->ap_shared != NULL)
+		return agg_shared_yield(agg_param->ap_shared);
+
+	return agg_yield(agg_param->ap_yield_func, agg_param->ap_yield_arg,
+			 &agg_param->ap_credits);
+}
+
+static inline bool
+agg_part_skip(struct vos_agg_param *agg_param, daos_unit_oid_t *oid)
+{
+	struct vos_agg_shared	*as = agg_param->ap_shared;
+
+	if (as == NULL)
+		return false;
+
+	return d_hash_murmur64((unsigned char *)oid, sizeof(*oid), BTR_MUR_SEED) % as->as_nr !=
+	       agg_param->ap_part;
+}
+
 static int
 vos_agg_filter(daos_handle_t ih, vos_iter_desc_t *desc, void *cb_arg, unsigned int *acts)
 {
 	struct vos_agg_param	*agg_param = cb_arg;
 	int			 rc = 0;
 
+	if (agg_param->ap_dirty_oid != NULL && desc->id_type == VOS_ITER_OBJ &&
+	    daos_unit_oid_compare(desc->id_oid, *agg_param->ap_dirty_oid) != 0) {
+		agg_param->ap_dirty_done = true;
+		*acts |= VOS_ITER_CB_EXIT;
+		return 0;
+	}
+
+	if (agg_param->ap_shared != NULL && desc->id_type == VOS_ITER_OBJ) {
+		if (agg_param->ap_shared->as_abort) {
+			*acts |= VOS_ITER_CB_EXIT;
+			return 0;
+		}
+		/* The object belongs to the partition of another ULT */
+		if (agg_part_skip(agg_param, &desc->id_oid)) {
+			*acts |= VOS_ITER_CB_SKIP;
+			return 0;
+		}
+	}
+
 	rc = need_aggregate(ih, agg_param, desc);
 	if (rc == 0) {
 		if (desc->id_type == VOS_ITER_OBJ) {
@@ -373,7 +476,7 @@ vos_agg_filter(daos_handle_t ih, vos_iter_desc_t *desc, void *cb_arg, unsigned i
 	}
 out:
 
-	if (credits_exhausted(&agg_param->ap_credits) ||
+	if (credits_exhausted(agg_credits(agg_param)) ||
 	    (DAOS_FAIL_CHECK(DAOS_VOS_AGG_RANDOM_YIELD) && (rand() % 2))) {
 		D_DEBUG(DB_EPC, "Credits exhausted, type:%u, acts:%u\n", desc->id_type, *acts);
 
@@ -497,7 +600,7 @@ vos_agg_sv(daos_handle_t ih, vos_iter_entry_t *entry,
 	D_ASSERT(agg_param != NULL);
 	D_ASSERT(entry->ie_epoch != 0);
 
-	credits_consume(&agg_param->ap_credits, AGG_OP_SCAN);
+	credits_consume(agg_credits(agg_param), AGG_OP_SCAN);
 
 	/* Discard */
 	if (agg_param->ap_discard)
@@ -663,7 +766,7 @@ delete_evt_entry(struct vos_agg_param *agg_param, struct vos_obj_iter *oiter,
 
 	if (vam && vam->vam_del_ev && !agg_param->ap_discard)
 		d_tm_inc_counter(vam->vam_del_ev, 1);
-	credits_consume(&agg_param->ap_credits, AGG_OP_DEL);
+	credits_consume(agg_credits(agg_param), AGG_OP_DEL);
 
 	return rc;
 }
@@ -1733,7 +1836,7 @@ flush_merge_window(daos_handle_t ih, struct vos_agg_param *agg_param,
 			DP_EXT(&mw->mw_ext), DP_RC(rc));
 		goto out;
 	}
-	credits_consume(&agg_param->ap_credits, AGG_OP_MERGE);
+	credits_consume(agg_credits(agg_param), AGG_OP_MERGE);
 out:
 	cleanup_segments(ih, mw, rc);
 	return rc;
@@ -2159,7 +2262,7 @@ vos_agg_ev(daos_handle_t ih, vos_iter_entry_t *entry,
 	recx2ext(&entry->ie_recx, &lgc_ext);
 	recx2ext(&entry->ie_orig_recx, &phy_ext);
 
-	credits_consume(&agg_param->ap_credits, AGG_OP_SCAN);
+	credits_consume(agg_credits(agg_param), AGG_OP_SCAN);
 
 	/* Discard */
 	if (agg_param->ap_discard) {
@@ -2288,7 +2391,7 @@ vos_aggregate_pre_cb(daos_handle_t ih, vos_iter_entry_t *entry,
 		return rc;
 	}
 
-	if (credits_exhausted(&agg_param->ap_credits) ||
+	if (credits_exhausted(agg_credits(agg_param)) ||
 	    (DAOS_FAIL_CHECK(DAOS_VOS_AGG_RANDOM_YIELD) && (rand() % 2))) {
 		D_DEBUG(DB_EPC, "Credits exhausted, type:%u, acts:%u\n", type, *acts);
 
@@ -2532,21 +2635,491 @@ merge_window_init(struct agg_merge_window *mw)
 	D_INIT_LIST_HEAD(&io->ic_nvme_exts);
 }
 
+/*
+ * Set of objects touched by aggregatable updates, so that aggregation can visit
+ * them only instead of scanning the whole object index. It lives in DRAM and
+ * starts tracking on container open, the updates made before that are bounded
+ * by @ad_bound, so the set covers all objects needing aggregation once HAE has
+ * passed @ad_bound. Objects are removed once HAE passed their updates.
+ */
+#define AGG_DIRTY_BITS	10
+
+struct agg_dirty_ent {
+	d_list_t		de_hlink;
+	d_list_t		de_link;
+	daos_unit_oid_t		de_oid;
+	/* Highest epoch of aggregatable updates */
+	daos_epoch_t		de_epoch;
+};
+
+struct vos_agg_dirty {
+	struct d_hash_table	ad_htable;
+	d_list_t		ad_list;
+	uint32_t		ad_count;
+	/* Aggregatable updates not tracked by the set are below this epoch */
+	daos_epoch_t		ad_bound;
+};
+
+static inline struct agg_dirty_ent *
+agg_dirty_hlink2ent(d_list_t *rlink)
+{
+	return container_of(rlink, struct agg_dirty_ent, de_hlink);
+}
+
+static bool
+agg_dirty_key_cmp(struct d_hash_table *htable, d_list_t *rlink, const void *key,
+		  unsigned int ksize)
+{
+	struct agg_dirty_ent	*ent = agg_dirty_hlink2ent(rlink);
+
+	D_ASSERT(ksize == sizeof(daos_unit_oid_t));
+	return daos_unit_oid_compare(ent->de_oid, *(daos_unit_oid_t *)key) == 0;
+}
+
+static uint32_t
+agg_dirty_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	return (uint32_t)d_hash_murmur64((unsigned char *)key, ksize, BTR_MUR_SEED);
+}
+
+static d_hash_table_ops_t agg_dirty_hash_ops = {
+	.hop_key_cmp	= agg_dirty_key_cmp,
+	.hop_key_hash	= agg_dirty_key_hash,
+};
+
+static void
+agg_dirty_del(struct vos_agg_dirty *dirty, struct agg_dirty_ent *ent)
+{
+	d_hash_rec_delete_at(&dirty->ad_htable, &ent->de_hlink);
+	d_list_del(&ent->de_link);
+	D_ASSERT(dirty->ad_count > 0);
+	dirty->ad_count--;
+	D_FREE(ent);
+}
+
+/* Drop all tracked objects, aggregation has to scan whole container until HAE passed @epoch */
+static void
+agg_dirty_reset(struct vos_agg_dirty *dirty, daos_epoch_t epoch)
+{
+	struct agg_dirty_ent	*ent, *tmp;
+
+	d_list_for_each_entry_safe(ent, tmp, &dirty->ad_list, de_link) {
+		if (ent->de_epoch > epoch)
+			epoch = ent->de_epoch;
+		agg_dirty_del(dirty, ent);
+	}
+
+	if (dirty->ad_bound < epoch)
+		dirty->ad_bound = epoch;
+}
+
+/* Remove the objects which don't have aggregatable updates above @epoch */
+static void
+agg_dirty_trim(struct vos_container *cont, daos_epoch_t epoch)
+{
+	struct vos_agg_dirty	*dirty = cont->vc_agg_dirty;
+	struct agg_dirty_ent	*ent, *tmp;
+
+	if (dirty == NULL)
+		return;
+
+	d_list_for_each_entry_safe(ent, tmp, &dirty->ad_list, de_link) {
+		if (ent->de_epoch <= epoch)
+			agg_dirty_del(dirty, ent);
+	}
+}
+
+static inline bool
+agg_dirty_valid(struct vos_container *cont)
+{
+	struct vos_agg_dirty	*dirty = cont->vc_agg_dirty;
+
+	return dirty != NULL && cont->vc_cont_df->cd_hae >= dirty->ad_bound;
+}
+
+int
+vos_agg_dirty_create(struct vos_container *cont)
+{
+	struct vos_agg_dirty	*dirty;
+	int			 rc;
+
+	/* Relies on the aggregatable updates being marked, see vos_mark_agg() */
+	if ((cont->vc_pool->vp_feats & VOS_POOL_FEAT_AGG_OPT) == 0)
+		return 0;
+
+	D_ALLOC_PTR(dirty);
+	if (dirty == NULL)
+		return -DER_NOMEM;
+
+	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, AGG_DIRTY_BITS, NULL,
+					 &agg_dirty_hash_ops, &dirty->ad_htable);
+	if (rc) {
+		D_FREE(dirty);
+		return rc;
+	}
+
+	D_INIT_LIST_HEAD(&dirty->ad_list);
+	dirty->ad_bound = crt_hlc_get() + crt_hlc_epsilon_get();
+	cont->vc_agg_dirty = dirty;
+
+	return 0;
+}
+
+void
+vos_agg_dirty_destroy(struct vos_container *cont)
+{
+	struct vos_agg_dirty	*dirty = cont->vc_agg_dirty;
+
+	if (dirty == NULL)
+		return;
+
+	agg_dirty_reset(dirty, 0);
+	d_hash_table_destroy_inplace(&dirty->ad_htable, true);
+	D_FREE(dirty);
+	cont->vc_agg_dirty = NULL;
+}
+
+void
+vos_agg_dirty_add(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_t epoch)
+{
+	struct vos_agg_dirty	*dirty = cont->vc_agg_dirty;
+	struct agg_dirty_ent	*ent;
+	d_list_t		*rlink;
+	int			 rc;
+
+	if (dirty == NULL)
+		return;
+
+	rlink = d_hash_rec_find(&dirty->ad_htable, &oid, sizeof(oid));
+	if (rlink != NULL) {
+		ent = agg_dirty_hlink2ent(rlink);
+		if (ent->de_epoch < epoch)
+			ent->de_epoch = epoch;
+		return;
+	}
+
+	if (dirty->ad_count >= AGG_DIRTY_MAX)
+		goto reset;
+
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		goto reset;
+
+	ent->de_oid = oid;
+	ent->de_epoch = epoch;
+	rc = d_hash_rec_insert(&dirty->ad_htable, &oid, sizeof(oid), &ent->de_hlink, true);
+	D_ASSERT(rc == 0);
+	d_list_add_tail(&ent->de_link, &dirty->ad_list);
+	dirty->ad_count++;
+	return;
+reset:
+	D_DEBUG(DB_EPC, DF_CONT": Too many dirty objects %u, fall back to full scan\n",
+		DP_CONT(cont->vc_pool->vp_id, cont->vc_id), dirty->ad_count);
+	agg_dirty_reset(dirty, epoch);
+}
+
+bool
+vos_agg_dirty_query(struct vos_container *cont, uint32_t *count)
+{
+	*count = cont->vc_agg_dirty != NULL ? cont->vc_agg_dirty->ad_count : 0;
+	return agg_dirty_valid(cont);
+}
+
 struct agg_data {
 	vos_iter_param_t	ad_iter_param;
 	struct vos_agg_param	ad_agg_param;
 	struct vos_iter_anchors	ad_anchors;
 };
 
+/* Worker ULT of parallel aggregation, it aggregates one partition of the object index */
+struct agg_worker {
+	struct agg_data		aw_data;
+	ABT_thread		aw_ult;
+	int			aw_rc;
+};
+
+static void
+agg_data_init(struct agg_data *ad, daos_handle_t coh, daos_epoch_range_t *epr,
+	      daos_epoch_t filter_epoch, int (*yield_func)(void *arg), void *yield_arg,
+	      uint32_t flags)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+
+	/* Set iteration parameters */
+	ad->ad_iter_param.ip_hdl = coh;
+	ad->ad_iter_param.ip_epr = *epr;
+	/*
+	 * Iterate in epoch reserve order for SV tree, so that we can know for
+	 * sure the first returned recx in SV tree has highest epoch and can't
+	 * be aggregated.
+	 */
+	ad->ad_iter_param.ip_epc_expr = VOS_IT_EPC_RR;
+	/* EV tree iterator returns all sorted logical rectangles */
+	ad->ad_iter_param.ip_flags = VOS_IT_PUNCHED | VOS_IT_RECX_COVERED | VOS_IT_FOR_PURGE;
+	ad->ad_iter_param.ip_filter_cb = vos_agg_filter;
+	ad->ad_iter_param.ip_filter_arg = &ad->ad_agg_param;
+
+	/* Set aggregation parameters */
+	ad->ad_agg_param.ap_filter_epoch = filter_epoch;
+	ad->ad_agg_param.ap_umm = &cont->vc_pool->vp_umm;
+	ad->ad_agg_param.ap_coh = coh;
+	credits_set(&ad->ad_agg_param.ap_credits, true);
+	ad->ad_agg_param.ap_discard = 0;
+	ad->ad_agg_param.ap_yield_func = yield_func;
+	ad->ad_agg_param.ap_yield_arg = yield_arg;
+	merge_window_init(&ad->ad_agg_param.ap_window);
+	ad->ad_agg_param.ap_flags = flags;
+}
+
+static inline int
+agg_data_iterate(struct agg_data *ad)
+{
+	return vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
+			   vos_aggregate_pre_cb, vos_aggregate_post_cb, &ad->ad_agg_param, NULL);
+}
+
+/*
+ * Close the merge window on failure, returns true if HAE can't be updated.
+ * Checksum error is returned in @rc but the HAE still needs be updated.
+ */
+static bool
+agg_data_fini(struct agg_data *ad, int *rc)
+{
+	if (*rc != 0 || ad->ad_agg_param.ap_nospc_err) {
+		close_merge_window(&ad->ad_agg_param.ap_window, *rc);
+		return true;
+	} else if (ad->ad_agg_param.ap_csum_err) {
+		*rc = -DER_CSUM;	/* Inform caller the csum error */
+		close_merge_window(&ad->ad_agg_param.ap_window, *rc);
+	}
+
+	return false;
+}
+
+static int
+agg_oid_cmp(const void *a, const void *b)
+{
+	return daos_unit_oid_compare(*(daos_unit_oid_t *)a, *(daos_unit_oid_t *)b);
+}
+
+/* Aggregate the objects in dirty object set only */
+static int
+agg_dirty_iterate(struct vos_container *cont, struct agg_data *ad)
+{
+	struct vos_agg_dirty	*dirty = cont->vc_agg_dirty;
+	struct agg_dirty_ent	*ent;
+	daos_unit_oid_t		*oids;
+	d_iov_t			 key;
+	uint32_t		 nr = 0;
+	uint32_t		 i;
+	int			 rc = 0;
+
+	if (dirty->ad_count == 0)
+		return 0;
+
+	/* Objects could be added on yield, work on a snapshot of the set */
+	D_ALLOC_ARRAY(oids, dirty->ad_count);
+	if (oids == NULL)
+		return -DER_NOMEM;
+
+	d_list_for_each_entry(ent, &dirty->ad_list, de_link)
+		oids[nr++] = ent->de_oid;
+	/* Visit objects in object index order */
+	qsort(oids, nr, sizeof(*oids), agg_oid_cmp);
+
+	D_DEBUG(DB_EPC, DF_CONT": Aggregate %u dirty objects\n",
+		DP_CONT(cont->vc_pool->vp_id, cont->vc_id), nr);
+
+	for (i = 0; i < nr; i++) {
+		memset(&ad->ad_anchors, 0, sizeof(ad->ad_anchors));
+		d_iov_set(&key, &oids[i], sizeof(oids[i]));
+		rc = dbtree_key2anchor(cont->vc_btr_hdl, &key, &ad->ad_anchors.ia_obj);
+		if (rc != 0)
+			break;
+
+		ad->ad_agg_param.ap_dirty_oid = &oids[i];
+		ad->ad_agg_param.ap_dirty_done = false;
+		rc = agg_data_iterate(ad);
+		/* Iterator exited on the object after the dirty one */
+		if (rc > 0 && ad->ad_agg_param.ap_dirty_done)
+			rc = 0;
+		if (rc != 0 || ad->ad_agg_param.ap_nospc_err)
+			break;
+	}
+
+	ad->ad_agg_param.ap_dirty_oid = NULL;
+	D_FREE(oids);
+
+	return rc;
+}
+
+static void
+agg_worker_ult(void *arg)
+{
+	struct agg_worker	*aw = arg;
+	struct vos_agg_shared	*as = aw->aw_data.ad_agg_param.ap_shared;
+
+	aw->aw_rc = agg_data_iterate(&aw->aw_data);
+
+	ABT_mutex_lock(as->as_mutex);
+	D_ASSERT(as->as_running > 0);
+	as->as_running--;
+	/* Stop other workers on failure or abort */
+	if (aw->aw_rc != 0)
+		as->as_abort = true;
+	ABT_cond_broadcast(as->as_cond);
+	ABT_mutex_unlock(as->as_mutex);
+}
+
+static inline unsigned int
+agg_ults_nr(void)
+{
+#ifdef VOS_STANDALONE
+	/* Iterator can't detect ULT switches in standalone mode */
+	return 1;
+#else
+	return vos_agg_ults;
+#endif
+}
+
+static inline int
+agg_worker_create(struct agg_worker *aw)
+{
+#ifdef VOS_STANDALONE
+	return -DER_NOSYS;
+#else
+	return dss_ult_create(agg_worker_ult, aw, DSS_XS_SELF, 0, DSS_DEEP_STACK_SZ,
+			      &aw->aw_ult);
+#endif
+}
+
+/*
+ * Run the workers and yield on behalf of them when the shared credits are
+ * exhausted, returns the number of created workers.
+ */
+static int
+agg_workers_run(struct vos_agg_shared *as, struct agg_worker *workers,
+		int (*yield_func)(void *arg), void *yield_arg)
+{
+	bool	abort;
+	int	i, rc;
+
+	for (i = 0; i < as->as_nr; i++) {
+		as->as_running++;
+		rc = agg_worker_create(&workers[i]);
+		if (rc) {
+			D_ERROR("Failed to create aggregation ULT %d/%u: "DF_RC"\n",
+				i, as->as_nr, DP_RC(rc));
+			as->as_running--;
+			as->as_abort = true;
+			workers[i].aw_rc = rc;
+			break;
+		}
+	}
+
+	ABT_mutex_lock(as->as_mutex);
+	while (as->as_running > 0) {
+		if (!as->as_yield_req) {
+			ABT_cond_wait(as->as_cond, as->as_mutex);
+			continue;
+		}
+
+		as->as_yield_req = false;
+		ABT_mutex_unlock(as->as_mutex);
+		abort = agg_yield(yield_func, yield_arg, &as->as_credits);
+		ABT_mutex_lock(as->as_mutex);
+
+		if (abort)
+			as->as_abort = true;
+		as->as_gen++;
+		ABT_cond_broadcast(as->as_cond);
+	}
+	ABT_mutex_unlock(as->as_mutex);
+
+	return i;
+}
+
+static int
+agg_parallel(daos_handle_t coh, daos_epoch_range_t *epr, daos_epoch_t filter_epoch,
+	     int (*yield_func)(void *arg), void *yield_arg, uint32_t flags, unsigned int nr,
+	     bool *skip_hae)
+{
+	struct vos_agg_shared	 as = { 0 };
+	struct agg_worker	*workers;
+	struct agg_data		*ad;
+	int			 created, i, rc = 0, tmp;
+
+	D_ALLOC_ARRAY(workers, nr);
+	if (workers == NULL)
+		return -DER_NOMEM;
+
+	rc = ABT_mutex_create(&as.as_mutex);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free_workers, rc = -DER_NOMEM);
+
+	rc = ABT_cond_create(&as.as_cond);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free_mutex, rc = -DER_NOMEM);
+
+	as.as_nr = nr;
+	credits_set(&as.as_credits, true);
+	for (i = 0; i < nr; i++) {
+		ad = &workers[i].aw_data;
+		agg_data_init(ad, coh, epr, filter_epoch, yield_func, yield_arg, flags);
+		ad->ad_agg_param.ap_shared = &as;
+		ad->ad_agg_param.ap_part = i;
+	}
+
+	created = agg_workers_run(&as, workers, yield_func, yield_arg);
+
+	rc = 0;
+	for (i = 0; i < nr; i++) {
+		ad = &workers[i].aw_data;
+		if (i < created)
+			ABT_thread_free(&workers[i].aw_ult);
+
+		tmp = workers[i].aw_rc;
+		if (agg_data_fini(ad, &tmp))
+			*skip_hae = true;
+		if (rc == 0 || rc == -DER_CSUM)
+			rc = tmp != 0 ? tmp : rc;
+
+		if (merge_window_status(&ad->ad_agg_param.ap_window) != MW_CLOSED)
+			D_ASSERTF(false, "Merge window resource leaked.\n");
+	}
+
+	ABT_cond_free(&as.as_cond);
+free_mutex:
+	ABT_mutex_free(&as.as_mutex);
+free_workers:
+	D_FREE(workers);
+	return rc;
+}
+
+static inline void
+agg_lag_update(struct vos_agg_metrics *vam, daos_epoch_t hae)
+{
+	uint64_t	now = crt_hlc_get();
+
+	if (vam == NULL || vam->vam_lag == NULL)
+		return;
+
+	d_tm_set_gauge(vam->vam_lag, now > hae ? crt_hlc2msec(now - hae) : 0);
+}
+
 int
 vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	      int (*yield_func)(void *arg), void *yield_arg, uint32_t flags)
 {
 	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct vos_agg_metrics	*vam = agg_cont2metrics(cont);
 	struct agg_data		*ad;
 	uint64_t		 feats;
 	daos_epoch_t		 agg_write;
+	daos_epoch_t		 filter_epoch;
 	bool			 has_agg_write;
+	bool			 skip_hae = false;
+	unsigned int		 nr = agg_ults_nr();
 	int			 rc;
 	bool			 run_agg = false;
 
@@ -2569,52 +3142,43 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	 *  the scan would be a noop anyway.
 	 */
 	if (flags & VOS_AGG_FL_FORCE_SCAN)
-		ad->ad_agg_param.ap_filter_epoch = epr->epr_lo;
+		filter_epoch = epr->epr_lo;
 	else
-		ad->ad_agg_param.ap_filter_epoch = cont->vc_cont_df->cd_hae;
+		filter_epoch = cont->vc_cont_df->cd_hae;
 
 	feats = dbtree_feats_get(&cont->vc_cont_df->cd_obj_root);
 	has_agg_write = vos_feats_agg_time_get(feats, &agg_write);
-	if (has_agg_write && agg_write <= ad->ad_agg_param.ap_filter_epoch)
+	if (has_agg_write && agg_write <= filter_epoch)
 		goto update_hae;
 
-	/* Set iteration parameters */
-	ad->ad_iter_param.ip_hdl = coh;
-	ad->ad_iter_param.ip_epr = *epr;
-	/*
-	 * Iterate in epoch reserve order for SV tree, so that we can know for
-	 * sure the first returned recx in SV tree has highest epoch and can't
-	 * be aggregated.
-	 */
-	ad->ad_iter_param.ip_epc_expr = VOS_IT_EPC_RR;
-	/* EV tree iterator returns all sorted logical rectangles */
-	ad->ad_iter_param.ip_flags = VOS_IT_PUNCHED | VOS_IT_RECX_COVERED;
-	ad->ad_iter_param.ip_filter_cb = vos_agg_filter;
-	ad->ad_iter_param.ip_filter_arg = &ad->ad_agg_param;
+	if (!(flags & VOS_AGG_FL_FORCE_SCAN) && agg_dirty_valid(cont)) {
+		agg_data_init(ad, coh, epr, filter_epoch, yield_func, yield_arg, flags);
+		run_agg = true;
 
-	/* Set aggregation parameters */
-	ad->ad_agg_param.ap_umm = &cont->vc_pool->vp_umm;
-	ad->ad_agg_param.ap_coh = coh;
-	credits_set(&ad->ad_agg_param.ap_credits, true);
-	ad->ad_agg_param.ap_discard = 0;
-	ad->ad_agg_param.ap_yield_func = yield_func;
-	ad->ad_agg_param.ap_yield_arg = yield_arg;
+		rc = agg_dirty_iterate(cont, ad);
+		if (agg_data_fini(ad, &rc))
+			goto exit;
+		goto update_hae;
+	}
+
+	if (vam && vam->vam_ults)
+		d_tm_set_gauge(vam->vam_ults, nr);
+
+	if (nr > 1) {
+		rc = agg_parallel(coh, epr, filter_epoch, yield_func, yield_arg, flags, nr,
+				  &skip_hae);
+		if (skip_hae)
+			goto exit;
+		goto update_hae;
+	}
+
+	agg_data_init(ad, coh, epr, filter_epoch, yield_func, yield_arg, flags);
 	run_agg = true;
-	merge_window_init(&ad->ad_agg_param.ap_window);
-	ad->ad_agg_param.ap_flags = flags;
 
-	ad->ad_iter_param.ip_flags |= VOS_IT_FOR_PURGE;
-	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
-			 vos_aggregate_pre_cb, vos_aggregate_post_cb,
-			 &ad->ad_agg_param, NULL);
-	if (rc != 0 || ad->ad_agg_param.ap_nospc_err) {
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
+	rc = agg_data_iterate(ad);
+	if (agg_data_fini(ad, &rc))
 		goto exit;
-	} else if (ad->ad_agg_param.ap_csum_err) {
-		rc = -DER_CSUM;	/* Inform caller the csum error */
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
-		/* HAE needs be updated for csum error case */
-	}
+	/* HAE needs be updated for csum error case */
 
 update_hae:
 	/*
@@ -2623,7 +3187,9 @@ update_hae:
 	 */
 	if (cont->vc_cont_df->cd_hae < epr->epr_hi)
 		cont->vc_cont_df->cd_hae = epr->epr_hi;
+	agg_dirty_trim(cont, epr->epr_hi);
 exit:
+	agg_lag_update(vam, cont->vc_cont_df->cd_hae);
 	aggregate_exit(cont, AGG_MODE_AGGREGATE);
 
 	if (run_agg && merge_window_status(&ad->ad_agg_param.ap_window) != MW_CLOSED)
@@ -368,6 +368,7 @@ vos_tls_fini(void *data)
 	if (tls->vtl_cont_hhash)
 		d_uhash_destroy(tls->vtl_cont_hhash);
 
+	umem_node_cache_fini();
 	umem_fini_txd(&tls->vtl_txd);
 	if (tls->vtl_ts_table)
 		vos_ts_table_free(&tls->vtl_ts_table);
@@ -378,6 +379,7 @@ static void *
 vos_tls_init(int xs_id, int tgt_id)
 {
 	struct vos_tls *tls;
+	unsigned int	nc_nr = 0;
 	int		rc;
 
 	D_ALLOC_PTR(tls);
@@ -419,6 +421,14 @@ vos_tls_init(int xs_id, int tgt_id)
 		goto failed;
 	}
 
+	/* Number of btree/evtree intermediate nodes cached in DRAM */
+	d_getenv_int("DAOS_VOS_NODE_CACHE", &nc_nr);
+	rc = umem_node_cache_init(nc_nr);
+	if (rc) {
+		D_ERROR("Error in creating node cache: "DF_RC"\n", DP_RC(rc));
+		goto failed;
+	}
+
 	if (tgt_id < 0)
 		/** skip sensor setup on standalone vos & sys xstream */
 		return tls;
@@ -431,6 +441,8 @@ vos_tls_init(int xs_id, int tgt_id)
 		D_WARN("Failed to create committed cnt sensor: "DF_RC"\n",
 		       DP_RC(rc));
 
+	vos_ts_table_metrics_init(tls->vtl_ts_table, tgt_id);
+
 	return tls;
 failed:
 	vos_tls_fini(tls);
@@ -449,6 +461,7 @@ daos_epoch_t	vos_start_epoch = DAOS_EPOCH_MAX;
 static int
 vos_mod_init(void)
 {
+	bool	 child_mbr = false;
 	int	 rc = 0;
 
 	if (vos_start_epoch == DAOS_EPOCH_MAX)
@@ -502,6 +515,17 @@ vos_mod_init(void)
 	D_INFO("Set aggregate NVMe record threshold to %u blocks (blk_sz:%lu).\n",
 	       vos_agg_nvme_thresh, VOS_BLK_SZ);
 
+	d_getenv_int("DAOS_VOS_AGG_ULTS", &vos_agg_ults);
+	if (vos_agg_ults == 0 || vos_agg_ults > VOS_AGG_ULTS_MAX)
+		vos_agg_ults = 1;
+	D_INFO("Set aggregation ULTs per container to %u.\n", vos_agg_ults);
+
+	d_getenv_bool("DAOS_EVTREE_CHILD_MBR", &child_mbr);
+	if (child_mbr) {
+		vos_evt_feats |= EVT_FEAT_CHILD_MBR;
+		D_INFO("Store child MBRs in evtree intermediate nodes\n");
+	}
+
 	return rc;
 }
 
@@ -636,6 +660,20 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create 'merged_size' telemetry : "DF_RC"\n", DP_RC(rc));
 
+	/* VOS aggregation ULTs used by last aggregation */
+	rc = d_tm_add_metric(&vam->vam_ults, D_TM_GAUGE, "aggregation ULTs", NULL,
+			     "%s/%s/ults/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'ults' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation HAE lag */
+	rc = d_tm_add_metric(&vam->vam_lag, D_TM_GAUGE, "aggregation lag", D_TM_MILLISECOND,
+			     "%s/%s/lag/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'lag' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	vos_gc_metrics_init(&vp_metrics->vp_gc_metrics, path, tgt_id);
+
 	return vp_metrics;
 }
 
@@ -794,14 +832,14 @@ vos_self_init(const char *db_path, bool use_sys_db, int tgt_id)
 	evt_mode = getenv("DAOS_EVTREE_MODE");
 	if (evt_mode) {
 		if (strcasecmp("soff", evt_mode) == 0) {
-			vos_evt_feats &= ~EVT_FEATS_SUPPORTED;
+			vos_evt_feats &= ~EVT_FEATS_POLICY;
 			vos_evt_feats |= EVT_FEAT_SORT_SOFF;
 		} else if (strcasecmp("dist_even", evt_mode) == 0) {
-			vos_evt_feats &= ~EVT_FEATS_SUPPORTED;
+			vos_evt_feats &= ~EVT_FEATS_POLICY;
 			vos_evt_feats |= EVT_FEAT_SORT_DIST_EVEN;
 		}
 	}
-	switch (vos_evt_feats & EVT_FEATS_SUPPORTED) {
+	switch (vos_evt_feats & EVT_FEATS_POLICY) {
 	case EVT_FEAT_SORT_SOFF:
 		D_INFO("Using start offset sort for evtree\n");
 		break;
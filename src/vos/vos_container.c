@@ -181,10 +181,16 @@ cont_free_internal(struct vos_container *cont)
 		dbtree_destroy(cont->vc_dtx_active_hdl, NULL);
 	if (daos_handle_is_valid(cont->vc_dtx_committed_hdl))
 		dbtree_destroy(cont->vc_dtx_committed_hdl, NULL);
+	vos_dtx_bloom_fini(cont);
 
 	if (cont->vc_dtx_array)
 		lrua_array_free(cont->vc_dtx_array);
 
+	if (cont->vc_ilog_vis_cache)
+		ilog_vis_cache_destroy(cont->vc_ilog_vis_cache);
+
+	vos_agg_dirty_destroy(cont);
+
 	D_ASSERT(d_list_empty(&cont->vc_dtx_act_list));
 
 	dbtree_close(cont->vc_btr_hdl);
@@ -398,6 +404,20 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		D_GOTO(exit, rc);
 	}
 
+	rc = ilog_vis_cache_create(&cont->vc_ilog_vis_cache);
+	if (rc != 0) {
+		D_ERROR("Failed to create ilog cache: rc = "DF_RC"\n",
+			DP_RC(rc));
+		D_GOTO(exit, rc);
+	}
+
+	rc = vos_agg_dirty_create(cont);
+	if (rc != 0) {
+		D_ERROR("Failed to create dirty object set: rc = "DF_RC"\n",
+			DP_RC(rc));
+		D_GOTO(exit, rc);
+	}
+
 	rc = dbtree_create_inplace_ex(VOS_BTR_DTX_ACT_TABLE, 0,
 				      DTX_BTREE_ORDER, &uma,
 				      &cont->vc_dtx_active_btr,
@@ -409,6 +429,7 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		D_GOTO(exit, rc);
 	}
 
+	vos_dtx_bloom_init(cont);
 	rc = dbtree_create_inplace_ex(VOS_BTR_DTX_CMT_TABLE, 0,
 				      DTX_BTREE_ORDER, &uma,
 				      &cont->vc_dtx_committed_btr,
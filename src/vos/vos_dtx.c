@@ -342,13 +342,200 @@ static btr_ops_t dtx_active_btr_ops = {
 	.to_rec_update	= dtx_act_ent_update,
 };
 
+static inline void
+dtx_bloom_hash(struct vos_dtx_bloom *bloom, struct dtx_id *dti, uint32_t *idx)
+{
+	uint64_t	hash;
+	uint32_t	h1;
+	uint32_t	h2;
+	uint32_t	mask = (1U << bloom->db_bits) - 1;
+	int		i;
+
+	hash = d_hash_murmur64((unsigned char *)dti, sizeof(*dti), VOS_BTR_DTX_CMT_TABLE);
+	h1 = (uint32_t)hash;
+	h2 = (uint32_t)(hash >> 32) | 1;
+	for (i = 0; i < DTX_BLOOM_HASHES; i++)
+		idx[i] = (h1 + i * h2) & mask;
+}
+
+static void
+dtx_bloom_add(struct vos_dtx_bloom *bloom, struct dtx_id *dti)
+{
+	uint32_t	idx[DTX_BLOOM_HASHES];
+	int		i;
+
+	if (bloom == NULL)
+		return;
+
+	dtx_bloom_hash(bloom, dti, idx);
+	for (i = 0; i < DTX_BLOOM_HASHES; i++) {
+		if (bloom->db_cnts[idx[i]] != UINT8_MAX)
+			bloom->db_cnts[idx[i]]++;
+	}
+	bloom->db_count++;
+}
+
+static void
+dtx_bloom_del(struct vos_dtx_bloom *bloom, struct dtx_id *dti)
+{
+	uint32_t	idx[DTX_BLOOM_HASHES];
+	int		i;
+
+	if (bloom == NULL)
+		return;
+
+	dtx_bloom_hash(bloom, dti, idx);
+	for (i = 0; i < DTX_BLOOM_HASHES; i++) {
+		if (bloom->db_cnts[idx[i]] != UINT8_MAX && bloom->db_cnts[idx[i]] != 0)
+			bloom->db_cnts[idx[i]]--;
+	}
+	if (bloom->db_count > 0)
+		bloom->db_count--;
+}
+
+static struct vos_dtx_bloom *
+dtx_bloom_alloc(uint32_t bits)
+{
+	struct vos_dtx_bloom	*bloom;
+
+	D_ALLOC(bloom, sizeof(*bloom) + (1UL << bits));
+	if (bloom != NULL)
+		bloom->db_bits = bits;
+
+	return bloom;
+}
+
+/* Lookup the committed DTX table, filter out most non-committed DTX via the bloom filter. */
+static int
+dtx_cmt_lookup(struct vos_container *cont, d_iov_t *kiov, d_iov_t *riov)
+{
+	struct vos_dtx_bloom	*bloom = cont->vc_dtx_bloom;
+	uint32_t		 idx[DTX_BLOOM_HASHES];
+	int			 i;
+
+	if (bloom == NULL)
+		goto lookup;
+
+	dtx_bloom_hash(bloom, kiov->iov_buf, idx);
+	for (i = 0; i < DTX_BLOOM_HASHES; i++) {
+		if (bloom->db_cnts[idx[i]] == 0)
+			return -DER_NONEXIST;
+	}
+
+lookup:
+	return dbtree_lookup(cont->vc_dtx_committed_hdl, kiov, riov);
+}
+
+void
+vos_dtx_bloom_init(struct vos_container *cont)
+{
+	D_ASSERT(cont->vc_dtx_bloom == NULL);
+
+	cont->vc_dtx_bloom = dtx_bloom_alloc(DTX_BLOOM_BITS_MIN);
+	if (cont->vc_dtx_bloom == NULL)
+		D_WARN("Failed to create DTX bloom filter for "DF_UUID"\n",
+		       DP_UUID(cont->vc_id));
+}
+
+void
+vos_dtx_bloom_fini(struct vos_container *cont)
+{
+	D_FREE(cont->vc_dtx_bloom_new);
+	D_FREE(cont->vc_dtx_bloom);
+}
+
+int
+vos_dtx_cmt_bloom_grow(daos_handle_t coh)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct vos_dtx_bloom	*bloom = cont->vc_dtx_bloom;
+	struct vos_dtx_bloom	*new = cont->vc_dtx_bloom_new;
+	struct vos_dtx_cmt_ent	*dce;
+	daos_handle_t		 ih;
+	d_iov_t			 riov;
+	uint32_t		 bits;
+	int			 cnt = 0;
+	int			 rc;
+
+	if (bloom == NULL || !daos_handle_is_valid(cont->vc_dtx_committed_hdl))
+		return 0;
+
+	if (new == NULL) {
+		bits = bloom->db_bits;
+		while (bits < DTX_BLOOM_BITS_MAX &&
+		       (1UL << bits) < (uint64_t)bloom->db_count * DTX_BLOOM_CNTS_PER_ENT)
+			bits++;
+
+		if (bits == bloom->db_bits)
+			return 0;
+
+		new = dtx_bloom_alloc(bits);
+		if (new == NULL)
+			return -DER_NOMEM;
+
+		cont->vc_dtx_bloom_new = new;
+		daos_anchor_set_zero(&cont->vc_dtx_bloom_anchor);
+	}
+
+	rc = dbtree_iter_prepare(cont->vc_dtx_committed_hdl, 0, &ih);
+	if (rc != 0)
+		goto out;
+
+	if (daos_anchor_is_zero(&cont->vc_dtx_bloom_anchor))
+		rc = dbtree_iter_probe(ih, BTR_PROBE_FIRST, DAOS_INTENT_DEFAULT, NULL, NULL);
+	else
+		rc = dbtree_iter_probe(ih, BTR_PROBE_GT, DAOS_INTENT_DEFAULT, NULL,
+				       &cont->vc_dtx_bloom_anchor);
+
+	while (rc == 0) {
+		d_iov_set(&riov, NULL, 0);
+		rc = dbtree_iter_fetch(ih, NULL, &riov, &cont->vc_dtx_bloom_anchor);
+		if (rc != 0)
+			break;
+
+		dce = riov.iov_buf;
+		dtx_bloom_add(new, &DCE_XID(dce));
+		if (++cnt >= DTX_BLOOM_GROW_BATCH)
+			break;
+
+		rc = dbtree_iter_next(ih);
+	}
+
+	dbtree_iter_finish(ih);
+
+out:
+	if (rc == 0)
+		return 1;
+
+	if (rc == -DER_NONEXIST) {
+		D_DEBUG(DB_TRACE, "Enlarged DTX bloom filter for "DF_UUID" from %u to %u bits\n",
+			DP_UUID(cont->vc_id), bloom->db_bits, new->db_bits);
+
+		new->db_count = bloom->db_count;
+		D_FREE(cont->vc_dtx_bloom);
+		cont->vc_dtx_bloom = new;
+		cont->vc_dtx_bloom_new = NULL;
+		return 0;
+	}
+
+	D_WARN("Failed to rebuild DTX bloom filter for "DF_UUID": "DF_RC"\n",
+	       DP_UUID(cont->vc_id), DP_RC(rc));
+	D_FREE(cont->vc_dtx_bloom_new);
+
+	return rc;
+}
+
 static int
 dtx_cmt_ent_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
 {
+	struct vos_container	*cont = tins->ti_priv;
 	struct vos_dtx_cmt_ent	*dce = val_iov->iov_buf;
 
 	rec->rec_off = umem_ptr2off(&tins->ti_umm, dce);
+	dtx_bloom_add(cont->vc_dtx_bloom, &DCE_XID(dce));
+	/* Someone may be re-added by the rebuild, that only causes false positive. */
+	dtx_bloom_add(cont->vc_dtx_bloom_new, &DCE_XID(dce));
 
 	return 0;
 }
@@ -357,11 +544,14 @@ static int
 dtx_cmt_ent_free(struct btr_instance *tins, struct btr_record *rec,
 		 void *args)
 {
+	struct vos_container	*cont = tins->ti_priv;
 	struct vos_dtx_cmt_ent	*dce;
 
 	dce = umem_off2ptr(&tins->ti_umm, rec->rec_off);
 	D_ASSERT(dce != NULL);
 
+	/* Not remove from the filter being rebuilt, it may not contain the DTX yet. */
+	dtx_bloom_del(cont->vc_dtx_bloom, &DCE_XID(dce));
 	rec->rec_off = UMOFF_NULL;
 	D_FREE(dce);
 
@@ -771,8 +961,7 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti, daos_epoch_t
 		d_iov_set(&riov, NULL, 0);
 		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 		if (rc == -DER_NONEXIST) {
-			rc = dbtree_lookup(cont->vc_dtx_committed_hdl,
-					   &kiov, &riov);
+			rc = dtx_cmt_lookup(cont, &kiov, &riov);
 			if (rc == 0) {
 				dce = (struct vos_dtx_cmt_ent *)riov.iov_buf;
 				if (dce->dce_invalid) {
@@ -1329,7 +1518,7 @@ vos_dtx_validation(struct dtx_handle *dth)
 		d_iov_set(&kiov, &dth->dth_xid, sizeof(dth->dth_xid));
 		d_iov_set(&riov, NULL, 0);
 
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+		rc = dtx_cmt_lookup(cont, &kiov, &riov);
 		if (rc == 0) {
 			D_DEBUG(DB_IO, "DTX "DF_DTI" is committed by race(1)\n",
 				DP_DTI(&dth->dth_xid));
@@ -1801,7 +1990,7 @@ vos_dtx_check(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t *epoch,
 	}
 
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+		rc = dtx_cmt_lookup(cont, &kiov, &riov);
 		if (rc == 0) {
 			struct vos_dtx_cmt_ent	*dce;
 
@@ -2097,7 +2286,7 @@ vos_dtx_abort(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t epoch)
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+		rc = dtx_cmt_lookup(cont, &kiov, &riov);
 		if (rc == 0) {
 			D_ERROR("NOT allow to abort a committed DTX (1) "DF_DTI"\n", DP_DTI(dti));
 			D_GOTO(out, rc = -DER_NO_PERM);
@@ -2175,7 +2364,7 @@ vos_dtx_set_flags(daos_handle_t coh, struct dtx_id *dti, uint32_t flags)
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 	if (rc == -DER_NONEXIST) {
-		rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+		rc = dtx_cmt_lookup(cont, &kiov, &riov);
 		if (rc == 0) {
 			D_ERROR("Not allow to set flag on committed/aborted DTX entry "DF_DTI"\n",
 				DP_DTI(dti));
@@ -2672,7 +2861,7 @@ vos_dtx_cleanup_internal(struct dtx_handle *dth)
 		d_iov_set(&riov, NULL, 0);
 		rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
 		if (rc == -DER_NONEXIST) {
-			rc = dbtree_lookup(cont->vc_dtx_committed_hdl, &kiov, &riov);
+			rc = dtx_cmt_lookup(cont, &kiov, &riov);
 			/* Cannot cleanup 'committed' DTX entry. */
 			if (rc == 0)
 				goto out;
@@ -2959,6 +3148,7 @@ cmt:
 		cont->vc_cmt_dtx_indexed = 0;
 	}
 
+	vos_dtx_bloom_fini(cont);
 	rc = dbtree_create_inplace_ex(VOS_BTR_DTX_CMT_TABLE, 0, DTX_BTREE_ORDER, &uma,
 				      &cont->vc_dtx_committed_btr, DAOS_HDL_INVAL, cont,
 				      &cont->vc_dtx_committed_hdl);
@@ -2968,6 +3158,8 @@ cmt:
 		return rc;
 	}
 
+	vos_dtx_bloom_init(cont);
+
 	D_DEBUG(DB_TRACE, "Reset DTX cache for "DF_UUID"\n", DP_UUID(cont->vc_id));
 
 	return 0;
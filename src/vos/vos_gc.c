@@ -20,8 +20,18 @@ enum {
 	GC_CREDS_SLACK	= 8,	/**< credits for slack mode */
 	GC_CREDS_TIGHT	= 32,	/**< credits for tight mode */
 	GC_CREDS_MAX	= 4096,	/**< maximum credits for vos_gc_run/pool() */
+	GC_CREDS_BATCH	= 256,	/**< maximum credits of a batch (transaction) */
 };
 
+/** Interval of GC rate controller sampling, in msecs */
+#define GC_SAMPLE_INTVL		1000
+/** Foreground I/O rate (per second) above which GC batch isn't enlarged in slack mode */
+#define GC_IO_RATE_BUSY		1000
+/** Maximum shift of batch credits based on backlog */
+#define GC_BATCH_SHIFT_MAX	3
+
+#define VOS_GC_DIR		"vos_gc"
+
 /**
  * Default garbage bag size consumes <= 4K space
  * - header of vos_gc_bag_df is 64 bytes
@@ -1100,6 +1110,141 @@ vos_gc_pool_tight(daos_handle_t poh, int *credits)
 	return 0;
 }
 
+static uint64_t
+gc_bin_items(struct umem_instance *umm, struct vos_gc_bin_df *bin)
+{
+	struct vos_gc_bag_df	*first;
+	struct vos_gc_bag_df	*last;
+
+	first = umem_off2ptr(umm, bin->bin_bag_first);
+	if (first == NULL)
+		return 0;
+
+	if (bin->bin_bag_nr <= 1)
+		return first->bag_item_nr;
+
+	last = umem_off2ptr(umm, bin->bin_bag_last);
+	return first->bag_item_nr + last->bag_item_nr +
+	       (uint64_t)(bin->bin_bag_nr - 2) * bin->bin_bag_size;
+}
+
+/** Count items waiting for GC in pool bins and bins of opened containers */
+static void
+gc_backlog(struct vos_pool *pool, uint64_t *backlog)
+{
+	struct umem_instance	*umm = &pool->vp_umm;
+	struct vos_container	*cont;
+	int			 i;
+
+	for (i = 0; i < GC_MAX; i++)
+		backlog[i] = gc_bin_items(umm, &pool->vp_pool_df->pd_gc_bins[i]);
+
+	d_list_for_each_entry(cont, &pool->vp_gc_cont, vc_gc_link) {
+		for (i = 0; i < GC_CONT; i++)
+			backlog[i] += gc_bin_items(umm, &cont->vc_cont_df->cd_gc_bins[i]);
+	}
+}
+
+/** Sample GC backlog, reclaim rate and foreground I/O rate of the pool */
+static void
+gc_ctl_sample(struct vos_pool *pool)
+{
+	struct vos_gc_ctl	*ctl = &pool->vp_gc_ctl;
+	struct vos_gc_stat	*stat = &pool->vp_gc_stat;
+	struct vos_gc_metrics	*vgm = NULL;
+	uint64_t		 backlog[GC_MAX];
+	uint64_t		 now = daos_getmtime_coarse();
+	uint64_t		 elapsed = now - ctl->gcc_ts;
+	uint64_t		 items;
+	int			 i;
+
+	if (ctl->gcc_ts != 0 && elapsed < GC_SAMPLE_INTVL)
+		return;
+
+	items = stat->gs_conts + stat->gs_objs + stat->gs_dkeys + stat->gs_akeys +
+		stat->gs_singvs + stat->gs_recxs;
+	if (ctl->gcc_ts != 0) {
+		ctl->gcc_reclaim_rate = (items - ctl->gcc_items) * 1000 / elapsed;
+		ctl->gcc_io_rate = (pool->vp_io_ops - ctl->gcc_io_ops) * 1000 / elapsed;
+	}
+	ctl->gcc_ts = now;
+	ctl->gcc_items = items;
+	ctl->gcc_io_ops = pool->vp_io_ops;
+
+	gc_backlog(pool, backlog);
+	ctl->gcc_backlog = 0;
+	for (i = 0; i < GC_MAX; i++)
+		ctl->gcc_backlog += backlog[i];
+
+	if (pool->vp_metrics != NULL)
+		vgm = &pool->vp_metrics->vp_gc_metrics;
+	if (vgm == NULL)
+		return;
+
+	for (i = 0; i < GC_MAX; i++)
+		d_tm_set_gauge(vgm->vgm_backlog[i], backlog[i]);
+	d_tm_set_gauge(vgm->vgm_reclaim_rate, ctl->gcc_reclaim_rate);
+	d_tm_set_gauge(vgm->vgm_io_rate, ctl->gcc_io_rate);
+}
+
+/**
+ * Credits of next GC batch (reclaimed in one transaction). The batch is enlarged
+ * as backlog grows so big deletion can be reclaimed in time, it's capped by tight
+ * mode credits when foreground is busy, and isn't enlarged at all if there is
+ * heavy foreground I/O.
+ */
+static int
+gc_batch_creds(struct vos_pool *pool, int creds)
+{
+	struct vos_gc_ctl	*ctl = &pool->vp_gc_ctl;
+	int			 max = GC_CREDS_BATCH;
+	int			 shift = 0;
+
+	if (creds < GC_CREDS_TIGHT) {
+		if (ctl->gcc_io_rate >= GC_IO_RATE_BUSY)
+			return creds;
+		max = GC_CREDS_TIGHT;
+	}
+
+	/* Double the batch for each 4X backlog over a bag */
+	if (ctl->gcc_backlog > gc_bag_size)
+		shift = (d_power2_nbits(min(ctl->gcc_backlog / gc_bag_size, UINT32_MAX)) + 1) / 2;
+
+	creds <<= min(shift, GC_BATCH_SHIFT_MAX);
+
+	return min(creds, max);
+}
+
+void
+vos_gc_metrics_init(struct vos_gc_metrics *vgm, const char *path, int tgt_id)
+{
+	int	i, rc;
+
+	for (i = 0; i < GC_MAX; i++) {
+		rc = d_tm_add_metric(&vgm->vgm_backlog[i], D_TM_GAUGE, "GC backlog", "items",
+				     "%s/%s/backlog_%s/tgt_%u", path, VOS_GC_DIR,
+				     gc_type2name(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create 'backlog_%s' telemetry : "DF_RC"\n",
+			       gc_type2name(i), DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&vgm->vgm_reclaim_rate, D_TM_GAUGE, "GC reclaim rate", "items/s",
+			     "%s/%s/reclaim_rate/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'reclaim_rate' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vgm->vgm_io_rate, D_TM_GAUGE, "foreground I/O rate", "ops/s",
+			     "%s/%s/io_rate/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'io_rate' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vgm->vgm_batch, D_TM_GAUGE, "GC batch credits", NULL,
+			     "%s/%s/batch/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'batch' telemetry : "DF_RC"\n", DP_RC(rc));
+}
+
 struct vos_gc_param {
 	int		(*vgc_yield_func)(void *arg);
 	void		*vgc_yield_arg;
@@ -1156,7 +1301,12 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 	tls->vtl_gc_running++;
 
 	while (1) {
-		int	creds = param.vgc_credits;
+		int	creds;
+
+		gc_ctl_sample(pool);
+		creds = gc_batch_creds(pool, param.vgc_credits);
+		if (pool->vp_metrics != NULL)
+			d_tm_set_gauge(pool->vp_metrics->vp_gc_metrics.vgm_batch, creds);
 
 		if (credits > 0 && (credits - total) < creds)
 			creds = credits - total;
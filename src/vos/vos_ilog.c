@@ -95,6 +95,8 @@ vos_ilog_desc_cbs_init(struct ilog_desc_cbs *cbs, daos_handle_t coh)
 	cbs->dc_log_add_args = NULL;
 	cbs->dc_log_del_cb = vos_ilog_del;
 	cbs->dc_log_del_args = (void *)(unsigned long)coh.cookie;
+	cbs->dc_vis_cache = daos_handle_is_valid(coh) ?
+			    vos_hdl2cont(coh)->vc_ilog_vis_cache : NULL;
 }
 
 /** Returns true if the entry is covered by a punch */
@@ -133,6 +133,11 @@ enum {
 
 extern unsigned int vos_agg_nvme_thresh;
 
+/* Maximum # of ULTs to aggregate a container in parallel */
+#define VOS_AGG_ULTS_MAX	8
+
+extern unsigned int vos_agg_ults;
+
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
 	D_ASSERT(bytes != 0);
@@ -176,14 +181,40 @@ struct vos_agg_metrics {
 	struct d_tm_node_t	*vam_del_ev;		/* Deleted EV records */
 	struct d_tm_node_t	*vam_merge_recs;	/* Total merged EV records */
 	struct d_tm_node_t	*vam_merge_size;	/* Total merged size */
+	struct d_tm_node_t	*vam_ults;		/* # of ULTs of last aggregation */
+	struct d_tm_node_t	*vam_lag;		/* HAE lag behind current time */
+};
+
+struct vos_gc_metrics {
+	struct d_tm_node_t	*vgm_backlog[GC_MAX];	/* Items waiting for GC */
+	struct d_tm_node_t	*vgm_reclaim_rate;	/* Reclaimed items per second */
+	struct d_tm_node_t	*vgm_io_rate;		/* Foreground I/O per second */
+	struct d_tm_node_t	*vgm_batch;		/* Credits of last GC batch */
 };
 
 struct vos_pool_metrics {
 	void			*vp_vea_metrics;
 	struct vos_agg_metrics	 vp_agg_metrics;
+	struct vos_gc_metrics	 vp_gc_metrics;
 	/* TODO: add more metrics for VOS */
 };
 
+/** State of GC rate controller, sampled periodically by vos_gc_pool() */
+struct vos_gc_ctl {
+	/* Timestamp of last sample in msecs */
+	uint64_t		gcc_ts;
+	/* Foreground I/O count on last sample */
+	uint64_t		gcc_io_ops;
+	/* Reclaimed item count on last sample */
+	uint64_t		gcc_items;
+	/* Foreground I/O per second */
+	uint64_t		gcc_io_rate;
+	/* Reclaimed items per second */
+	uint64_t		gcc_reclaim_rate;
+	/* Items waiting for GC on last sample */
+	uint64_t		gcc_backlog;
+};
+
 /**
  * VOS pool (DRAM)
  */
@@ -211,6 +242,10 @@ struct vos_pool {
 	daos_handle_t		vp_cont_th;
 	/** GC statistics of this pool */
 	struct vos_gc_stat	vp_gc_stat;
+	/** GC rate controller */
+	struct vos_gc_ctl	vp_gc_ctl;
+	/** Foreground I/O count, sampled by GC rate controller */
+	uint64_t		vp_io_ops;
 	/** link chain on vos_tls::vtl_gc_pools */
 	d_list_t		vp_gc_link;
 	/** List of open containers with objects in gc pool */
@@ -248,10 +283,19 @@ struct vos_container {
 	daos_handle_t		vc_btr_hdl;
 	/** Array for active DTX records */
 	struct lru_array	*vc_dtx_array;
+	/** DRAM cache of persisted incarnation logs */
+	struct ilog_vis_cache	*vc_ilog_vis_cache;
+	/** Objects touched by aggregatable updates since last aggregation */
+	struct vos_agg_dirty	*vc_agg_dirty;
 	/* The handle for active DTX table */
 	daos_handle_t		vc_dtx_active_hdl;
 	/* The handle for committed DTX table */
 	daos_handle_t		vc_dtx_committed_hdl;
+	/** Counting bloom filter for negative lookup in committed DTX table */
+	struct vos_dtx_bloom	*vc_dtx_bloom;
+	/** The enlarged bloom filter being rebuilt, and the rebuild position */
+	struct vos_dtx_bloom	*vc_dtx_bloom_new;
+	daos_anchor_t		vc_dtx_bloom_anchor;
 	/** The root of the B+ tree for active DTXs. */
 	struct btr_root		vc_dtx_active_btr;
 	/** The root of the B+ tree for committed DTXs. */
@@ -518,6 +562,50 @@ vos_dtx_table_destroy(struct umem_instance *umm, struct vos_cont_df *cont_df);
 int
 vos_dtx_table_register(void);
 
+/**
+ * Initial and max counters count (log2) of the committed DTX bloom filter. It starts
+ * small since every opened container has one, and is enlarged on demand.
+ */
+#define DTX_BLOOM_BITS_MIN	10
+#define DTX_BLOOM_BITS_MAX	25
+/** Counters per committed DTX entry, the filter is enlarged if exceeds that. */
+#define DTX_BLOOM_CNTS_PER_ENT	8
+/** Committed DTX entries re-added into the enlarged filter per rebuild step. */
+#define DTX_BLOOM_GROW_BATCH	4096
+/** Probes per DTX ID, about 2% false positive with above density. */
+#define DTX_BLOOM_HASHES	4
+
+/**
+ * Counting bloom filter in DRAM that covers all the DTX IDs in the committed
+ * DTX table, so that the common lookup for non-committed (or non-resent) DTX
+ * can be answered without probing the committed DTX btree. Saturated counters
+ * are never decreased, that may cause false positive but not false negative.
+ */
+struct vos_dtx_bloom {
+	/** log2 of counters count */
+	uint32_t		db_bits;
+	/** The count of DTX IDs in the filter */
+	uint32_t		db_count;
+	uint8_t			db_cnts[0];
+};
+
+/**
+ * Create the bloom filter for the (empty) committed DTX table. The failure is
+ * not fatal, the lookup will always fall back to the committed DTX table.
+ *
+ * \param cont		[IN]	Pointer to the VOS container.
+ */
+void
+vos_dtx_bloom_init(struct vos_container *cont);
+
+/**
+ * Free the bloom filter for the committed DTX table.
+ *
+ * \param cont		[IN]	Pointer to the VOS container.
+ */
+void
+vos_dtx_bloom_fini(struct vos_container *cont);
+
 /** Cleanup the dtx handle when aborting a transaction. */
 void
 vos_dtx_cleanup_internal(struct dtx_handle *dth);
@@ -1200,6 +1288,8 @@ int
 vos_gc_pool_tight(daos_handle_t poh, int *credits);
 void
 gc_reserve_space(daos_size_t *rsrvd);
+void
+vos_gc_metrics_init(struct vos_gc_metrics *vgm, const char *path, int tgt_id);
 
 /**
  * If the object is fully punched, bypass normal aggregation and move it to container
@@ -1295,7 +1385,15 @@ enum {
 	VOS_SLAB_EVT_DESC	= 4,
 	VOS_SLAB_OBJ_DF		= 5,
 	VOS_SLAB_EVT_NODE_SM	= 6,
-	VOS_SLAB_MAX		= 7
+	/** size classes of small records, see vos_slab_rec_alloc() */
+	VOS_SLAB_REC_64		= 7,
+	VOS_SLAB_REC_96		= 8,
+	VOS_SLAB_REC_128	= 9,
+	VOS_SLAB_REC_192	= 10,
+	VOS_SLAB_REC_256	= 11,
+	VOS_SLAB_REC_384	= 12,
+	VOS_SLAB_REC_512	= 13,
+	VOS_SLAB_MAX		= 14
 };
 D_CASSERT(VOS_SLAB_MAX <= UMM_SLABS_CNT);
 
@@ -1313,6 +1411,40 @@ vos_slab_alloc(struct umem_instance *umm, int size, int slab_id)
 					POBJ_FLAG_ZERO, size);
 }
 
+/**
+ * Find the smallest size class for a small record of \a size bytes, return
+ * -1 if the record is too large or slabs are not registered.
+ */
+static inline int
+vos_slab_rec_class(struct umem_instance *umm, size_t size)
+{
+	int	id;
+
+	for (id = VOS_SLAB_REC_64; id < VOS_SLAB_MAX; id++) {
+		if (!umem_slab_registered(umm, id))
+			return -1;
+		if (size <= umem_slab_usize(umm, id))
+			return id;
+	}
+	return -1;
+}
+
+/**
+ * Allocate a zeroed small record (key record, incarnation log array, etc.)
+ * from the slab of its size class, so it is carved from runs of the class
+ * instead of the generic heap. Larger records fall back to umem_zalloc().
+ */
+static inline umem_off_t
+vos_slab_rec_alloc(struct umem_instance *umm, size_t size)
+{
+	int	id = vos_slab_rec_class(umm, size);
+
+	if (id < 0)
+		return umem_zalloc(umm, size);
+
+	return vos_slab_alloc(umm, umem_slab_usize(umm, id), id);
+}
+
 /* vos_space.c */
 void
 vos_space_sys_init(struct vos_pool *pool);
@@ -1487,15 +1619,40 @@ recx_csum_len(daos_recx_t *recx, struct dcs_csum_info *csum,
 /** Mark that the object and container need aggregation.
  *
  * \param[in] cont	VOS container
- * \param[in] dkey_root	Root of dkey tree (marked for object)
- * \param[in] obj_root	Root of object tree (marked for container)
+ * \param[in] obj	VOS object, its dkey tree root is marked and it's
+ *			recorded in the container dirty object set
  * \param[in] epoch	Epoch of aggregatable update
  *
  * \return 0 on success, error otherwise
  */
 int
-vos_mark_agg(struct vos_container *cont, struct btr_root *dkey_root, struct btr_root *obj_root,
-	     daos_epoch_t epoch);
+vos_mark_agg(struct vos_container *cont, struct vos_object *obj, daos_epoch_t epoch);
+
+/** Max number of objects tracked by the dirty object set before falling back to full scan */
+#define AGG_DIRTY_MAX	(1 << 16)
+
+/** Create the set of objects touched by aggregatable updates for container */
+int
+vos_agg_dirty_create(struct vos_container *cont);
+
+/** Destroy the set of objects touched by aggregatable updates for container */
+void
+vos_agg_dirty_destroy(struct vos_container *cont);
+
+/** Record the object touched by aggregatable update at \a epoch */
+void
+vos_agg_dirty_add(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_t epoch);
+
+/**
+ * Query the dirty object set of container, used by test.
+ *
+ * \param[in] cont	VOS container
+ * \param[out] count	Number of tracked objects
+ *
+ * \return true if next aggregation can visit the tracked objects only
+ */
+bool
+vos_agg_dirty_query(struct vos_container *cont, uint32_t *count);
 
 /** Mark that the key needs aggregation.
  *
@@ -630,6 +630,7 @@ vos_ioc_create(daos_handle_t coh, daos_unit_oid_t oid, bool read_only,
 	ioc->ic_oid = oid;
 	ioc->ic_cont = vos_hdl2cont(coh);
 	vos_cont_addref(ioc->ic_cont);
+	ioc->ic_cont->vc_pool->vp_io_ops++;
 	ioc->ic_update = !read_only;
 	ioc->ic_size_fetch = ((vos_flags & VOS_OF_FETCH_SIZE_ONLY) != 0);
 	ioc->ic_save_recx = ((vos_flags & VOS_OF_FETCH_RECX_LIST) != 0);
@@ -1671,8 +1672,7 @@ vos_key_mark_agg(struct vos_container *cont, struct vos_krec_df *krec, daos_epoc
 }
 
 int
-vos_mark_agg(struct vos_container *cont, struct btr_root *dkey_root, struct btr_root *obj_root,
-	     daos_epoch_t epoch)
+vos_mark_agg(struct vos_container *cont, struct vos_object *obj, daos_epoch_t epoch)
 {
 	struct umem_instance	*umm;
 	int			 rc;
@@ -1681,9 +1681,11 @@ vos_mark_agg(struct vos_container *cont, struct btr_root *dkey_root, struct btr_
 		return 0;
 
 	umm = vos_cont2umm(cont);
-	rc = vos_btr_mark_agg(umm, dkey_root, epoch);
+	rc = vos_btr_mark_agg(umm, &obj->obj_df->vo_tree, epoch);
 	if (rc == 0)
-		rc = vos_btr_mark_agg(umm, obj_root, epoch);
+		rc = vos_btr_mark_agg(umm, &cont->vc_cont_df->cd_obj_root, epoch);
+	if (rc == 0)
+		vos_agg_dirty_add(cont, obj->obj_id, epoch);
 
 	return rc;
 }
@@ -1694,8 +1696,7 @@ vos_ioc_mark_agg(struct vos_io_context *ioc)
 	if (!ioc->ic_agg_needed)
 		return 0;
 
-	return vos_mark_agg(ioc->ic_cont, &ioc->ic_obj->obj_df->vo_tree,
-			    &ioc->ic_cont->vc_cont_df->cd_obj_root, ioc->ic_epr.epr_hi);
+	return vos_mark_agg(ioc->ic_cont, ioc->ic_obj, ioc->ic_epr.epr_hi);
 }
 
 static int
@@ -1919,19 +1920,29 @@ umem_off_t
 vos_reserve_scm(struct vos_container *cont, struct vos_rsrvd_scm *rsrvd_scm,
 		daos_size_t size)
 {
-	umem_off_t	umoff;
+	struct umem_instance	*umm = vos_cont2umm(cont);
+	umem_off_t		 umoff;
 
 	D_ASSERT(size > 0);
 
-	if (vos_cont2umm(cont)->umm_ops->mo_reserve != NULL) {
-		struct pobj_action *act;
+	if (umm->umm_ops->mo_reserve != NULL) {
+		struct pobj_action	*act;
+		uint64_t		 flags = 0;
+		int			 slab_id;
 
 		D_ASSERT(rsrvd_scm != NULL);
 		D_ASSERT(rsrvd_scm->rs_actv_cnt > rsrvd_scm->rs_actv_at);
 
 		act = &rsrvd_scm->rs_actv[rsrvd_scm->rs_actv_at];
 
-		umoff = umem_reserve(vos_cont2umm(cont), act, size);
+		/* small records are reserved from the slab of size class */
+		slab_id = vos_slab_rec_class(umm, size);
+		if (slab_id >= 0) {
+			flags = umem_slab_flags(umm, slab_id);
+			size = umem_slab_usize(umm, slab_id);
+		}
+
+		umoff = umem_reserve_verb(umm, act, flags, size);
 		if (!UMOFF_IS_NULL(umoff))
 			rsrvd_scm->rs_actv_at++;
 	} else {
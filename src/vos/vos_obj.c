@@ -504,8 +504,7 @@ vos_obj_punch(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch,
 			}
 
 			if (rc == 0)
-				rc = vos_mark_agg(cont, &obj->obj_df->vo_tree,
-						  &cont->vc_cont_df->cd_obj_root, epoch);
+				rc = vos_mark_agg(cont, obj, epoch);
 
 			vos_obj_release(vos_obj_cache_current(), obj, rc != 0);
 		}
@@ -2044,10 +2043,11 @@ vos_obj_iter_aggregate(daos_handle_t ih, bool range_discard)
 	krec = rbund.rb_krec;
 	umm = vos_obj2umm(oiter->it_obj);
 
-	rc = umem_tx_begin(umm, NULL);
-	if (rc != 0)
-		goto exit;
-
+	/* The incarnation log only starts a transaction if it has entries to
+	 * remove, so most keys are aggregated without one.  An emptied log is
+	 * treated as a deleted key, so removing the key in a separate
+	 * transaction is safe.
+	 */
 	rc = vos_ilog_aggregate(vos_cont2hdl(obj->obj_cont), &krec->kr_ilog,
 				&oiter->it_epr, iter->it_for_discard, false,
 				&oiter->it_punched, &oiter->it_ilog_info);
@@ -2058,20 +2058,24 @@ vos_obj_iter_aggregate(daos_handle_t ih, bool range_discard)
 		D_DEBUG(DB_IO, "Removing %s from tree\n",
 			iter->it_type == VOS_ITER_DKEY ? "dkey" : "akey");
 
+		rc = umem_tx_begin(umm, NULL);
+		if (rc != 0)
+			goto exit;
+
 		/* XXX: The value tree may be not empty because related prepared transaction can
 		 *	be aborted. Then it will be added and handled via GC when ktr_rec_free().
 		 */
 
 		rc = dbtree_iter_delete(oiter->it_hdl, NULL);
 		D_ASSERT(rc != -DER_NONEXIST);
+
+		rc = umem_tx_end(umm, rc);
 	} else if (rc == -DER_NONEXIST) {
 		/* Key no longer exists at epoch but isn't empty */
 		invisible = true;
 		rc = 0;
 	}
 
-	rc = umem_tx_end(umm, rc);
-
 exit:
 	if (rc == 0 && (delete || invisible))
 		return delete ? 1 : 2;
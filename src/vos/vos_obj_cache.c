@@ -11,9 +11,9 @@
  *
  * LRU cache implementation:
  * Simple LRU based object cache for Object index table
- * Uses a hashtable and a doubly linked list to set and get
- * entries. The size of both hashtable and linked list are
- * fixed length.
+ * Uses a hashtable and a CLOCK ring to set and get entries,
+ * recently held objects are found without hash lookup. The
+ * size of both hashtable and CLOCK ring are fixed length.
  *
  * Author: Vishwanath Venkatesan <vishwanath.venkatesan@intel.com>
  */
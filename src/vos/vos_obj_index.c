@@ -778,10 +778,7 @@ oi_iter_aggregate(daos_handle_t ih, bool range_discard)
 	obj = (struct vos_obj_df *)rec_iov.iov_buf;
 	oid = obj->vo_id;
 
-	rc = umem_tx_begin(vos_cont2umm(oiter->oit_cont), NULL);
-	if (rc != 0)
-		goto exit;
-
+	/* No transaction unless the object is deleted, see vos_obj_iter_aggregate */
 	rc = vos_ilog_aggregate(vos_cont2hdl(oiter->oit_cont), &obj->vo_ilog,
 				&oiter->oit_epr, iter->it_for_discard, false, NULL,
 				&oiter->oit_ilog_info);
@@ -791,6 +788,10 @@ oi_iter_aggregate(daos_handle_t ih, bool range_discard)
 			DP_UOID(oid));
 		delete = true;
 
+		rc = umem_tx_begin(vos_cont2umm(oiter->oit_cont), NULL);
+		if (rc != 0)
+			goto exit;
+
 		/* XXX: The dkey tree may be not empty because related prepared transaction can
 		 *	be aborted. Then it will be added and handled via GC when oi_rec_free().
 		 */
@@ -803,13 +804,13 @@ oi_iter_aggregate(daos_handle_t ih, bool range_discard)
 				DP_UOID(oid), DP_RC(rc));
 		rc = dbtree_iter_delete(oiter->oit_hdl, NULL);
 		D_ASSERT(rc != -DER_NONEXIST);
+
+		rc = umem_tx_end(vos_cont2umm(oiter->oit_cont), rc);
 	} else if (rc == -DER_NONEXIST) {
 		/** ilog isn't visible in range but still has some enrtries */
 		invisible = true;
 		rc = 0;
 	}
-
-	rc = umem_tx_end(vos_cont2umm(oiter->oit_cont), rc);
 exit:
 	if (rc == 0 && (delete || invisible))
 		return delete ? 1 : 2;
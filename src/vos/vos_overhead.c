@@ -35,7 +35,7 @@ vos_tree_get_overhead(int alloc_overhead, enum VOS_TREE_CLASS tclass,
 	memset(ovhd, 0, sizeof(*ovhd));
 
 	if (tclass == VOS_TC_ARRAY) {
-		rc = evt_overhead_get(alloc_overhead, VOS_EVT_ORDER, ovhd);
+		rc = evt_overhead_get(alloc_overhead, otype, VOS_EVT_ORDER, ovhd);
 		goto out;
 	}
 
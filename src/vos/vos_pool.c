@@ -518,6 +518,12 @@ exit:
 	return rc;
 }
 
+/** Unit sizes of VOS_SLAB_REC_64 ... VOS_SLAB_REC_512 */
+static const size_t vos_slab_rec_sizes[] = {
+	64, 96, 128, 192, 256, 384, 512,
+};
+D_CASSERT(ARRAY_SIZE(vos_slab_rec_sizes) == VOS_SLAB_MAX - VOS_SLAB_REC_64);
+
 static int
 set_slab_prop(int id, struct pobj_alloc_class_desc *slab)
 {
@@ -529,6 +535,11 @@ set_slab_prop(int id, struct pobj_alloc_class_desc *slab)
 		goto done;
 	}
 
+	if (id >= VOS_SLAB_REC_64) {
+		slab->unit_size = vos_slab_rec_sizes[id - VOS_SLAB_REC_64];
+		goto done;
+	}
+
 	size = &ovhd.to_leaf_overhead.no_size;
 
 	switch (id) {
@@ -29,6 +29,15 @@ static const uint32_t type_counts[] = {
 #define DKEY_MISS_SIZE (1 << 16)
 #define AKEY_MISS_SIZE (1 << 16)
 
+/** Allocations per resize window, as a shift of the cache size */
+#define TS_WIN_SHIFT	3
+/** Smallest soft limit, as a shift of the cache size */
+#define TS_MIN_SHIFT	3
+/** Largest soft limit, as a shift of the cache size.  Entries above the
+ *  cache size are only initialized if the limit grows to cover them.
+ */
+#define TS_MAX_SHIFT	2
+
 #define TS_TRACE(action, entry, idx, type)				\
 	D_DEBUG(DB_TRACE, "%s %s at idx %d(%p), read.hi="DF_U64		\
 		" read.lo="DF_U64"\n", action, type_strs[type], idx,	\
@@ -178,11 +187,12 @@ vos_ts_table_alloc(struct vos_ts_table **ts_tablep)
 			}
 		}
 
-		rc = lrua_array_alloc(&info->ti_array, info->ti_count, 1,
+		rc = lrua_array_alloc(&info->ti_array, info->ti_count << TS_MAX_SHIFT, 1,
 				      sizeof(struct vos_ts_entry), 0, &lru_cbs,
 				      info);
 		if (rc != 0)
 			goto cleanup;
+		lrua_array_set_limit(info->ti_array, info->ti_count);
 	}
 
 	*ts_tablep = ts_table;
@@ -199,6 +209,87 @@ free_table:
 	return rc;
 }
 
+void
+vos_ts_table_metrics_init(struct vos_ts_table *ts_table, int tgt_id)
+{
+	struct vos_ts_info	*info;
+	uint32_t		 i;
+	int			 rc;
+
+	for (i = 0; i < VOS_TS_TYPE_COUNT; i++) {
+		info = &ts_table->tt_type_info[i];
+		info->ti_adaptive = true;
+		info->ti_win_evicted = info->ti_array->la_evicted;
+
+		rc = d_tm_add_metric(&info->ti_hits, D_TM_COUNTER,
+				     "Timestamp cache hits", "entries",
+				     "vos/ts_cache/%s/hits/tgt_%u", type_strs[i], tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts cache hits telemetry: "DF_RC"\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&info->ti_evictions, D_TM_COUNTER,
+				     "Timestamp cache evictions", "entries",
+				     "vos/ts_cache/%s/evictions/tgt_%u", type_strs[i], tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts cache evictions telemetry: "DF_RC"\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&info->ti_restarts, D_TM_COUNTER,
+				     "Transaction restarts on read timestamp conflicts", "ops",
+				     "vos/ts_cache/%s/restarts/tgt_%u", type_strs[i], tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts cache restarts telemetry: "DF_RC"\n",
+			       DP_RC(rc));
+
+		rc = d_tm_add_metric(&info->ti_limit, D_TM_GAUGE,
+				     "Timestamp cache size limit", "entries",
+				     "vos/ts_cache/%s/limit/tgt_%u", type_strs[i], tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts cache limit telemetry: "DF_RC"\n",
+			       DP_RC(rc));
+		d_tm_set_gauge(info->ti_limit, info->ti_array->la_limit);
+	}
+}
+
+/** Resize the cache at the end of each window of allocations.  Double the
+ *  limit, up to the size of the LRU array, when most allocations had to
+ *  evict a live entry, since evicted
+ *  timestamps are folded into the shared negative entries and cause false
+ *  conflicts.  Halve it when nothing was evicted and most of the cache is
+ *  idle, to keep the active entries dense.
+ */
+static void
+ts_cache_resize(struct vos_ts_info *info)
+{
+	struct lru_array	*array = info->ti_array;
+	uint32_t		 win = info->ti_count >> TS_WIN_SHIFT;
+	uint32_t		 limit = array->la_limit;
+	uint64_t		 evicted;
+
+	if (++info->ti_win_allocs < win)
+		return;
+
+	evicted = array->la_evicted - info->ti_win_evicted;
+	d_tm_inc_counter(info->ti_evictions, evicted);
+
+	if (evicted > win / 2 && limit < array->la_count)
+		limit <<= 1;
+	else if (evicted == 0 && array->la_used < limit / 4 &&
+		 limit > (info->ti_count >> TS_MIN_SHIFT))
+		limit >>= 1;
+
+	if (limit != array->la_limit) {
+		D_DEBUG(DB_TRACE, "Resize %s ts cache %u -> %u, "DF_U64" evicted\n",
+			type_strs[info->ti_type], array->la_limit, limit, evicted);
+		lrua_array_set_limit(array, limit);
+		d_tm_set_gauge(info->ti_limit, array->la_limit);
+	}
+
+	info->ti_win_allocs = 0;
+	info->ti_win_evicted = array->la_evicted;
+}
+
 void
 vos_ts_table_free(struct vos_ts_table **ts_tablep)
 {
@@ -226,6 +317,9 @@ vos_ts_evict_lru(struct vos_ts_table *ts_table, struct vos_ts_entry **entryp,
 	rc = lrua_alloc(ts_table->tt_type_info[type].ti_array, idx, &entry);
 	D_ASSERT(rc == 0); /** autoeviction and no allocation */
 
+	if (info->ti_adaptive)
+		ts_cache_resize(info);
+
 	if (info->ti_cache_mask)
 		neg_entry = &info->ti_misses[hash_idx];
 
@@ -351,9 +445,8 @@ vos_ts_check_conflict(daos_epoch_t read_time, const struct dtx_id *read_id,
 	return uuid_compare(read_id->dti_uuid, write_id->dti_uuid) != 0;
 }
 
-bool
-vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
-			   daos_epoch_t write_time)
+static bool
+ts_check_read_conflict(struct vos_ts_set *ts_set, int idx, daos_epoch_t write_time)
 {
 	struct vos_ts_set_entry	*se;
 	struct vos_ts_entry	*entry;
@@ -401,3 +494,18 @@ vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
 				     &entry->te_negative->te_ts.tp_tx_rh, write_time,
 				     &ts_set->ts_tx_id);
 }
+
+bool
+vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
+			   daos_epoch_t write_time)
+{
+	struct vos_ts_entry	*entry;
+
+	if (!ts_check_read_conflict(ts_set, idx, write_time))
+		return false;
+
+	entry = ts_set->ts_entries[idx].se_entry;
+	d_tm_inc_counter(entry->te_info->ti_restarts, 1);
+
+	return true;
+}
@@ -33,6 +33,20 @@ struct vos_ts_info {
 	uint32_t		ti_cache_mask;
 	/** Number of entries in cache for type (for testing) */
 	uint32_t		ti_count;
+	/** Resize the cache based on the eviction rate */
+	bool			ti_adaptive;
+	/** Allocations in the current resize window */
+	uint32_t		ti_win_allocs;
+	/** Eviction count of the LRU array at start of the window */
+	uint64_t		ti_win_evicted;
+	/** Cache hits */
+	struct d_tm_node_t	*ti_hits;
+	/** Entries evicted to make room for new ones */
+	struct d_tm_node_t	*ti_evictions;
+	/** Read/write conflicts causing a transaction restart */
+	struct d_tm_node_t	*ti_restarts;
+	/** Current soft limit of the cache */
+	struct d_tm_node_t	*ti_limit;
 };
 
 struct vos_ts_pair {
@@ -242,6 +256,7 @@ vos_ts_lookup_internal(struct vos_ts_set *ts_set, uint32_t type, uint32_t *idx,
 
 	found = lrua_lookup(info->ti_array, idx, &entry);
 	if (found) {
+		d_tm_inc_counter(info->ti_hits, 1);
 		D_ASSERT(ts_set->ts_set_size != ts_set->ts_init_count);
 		set_entry.se_entry = entry;
 		ts_set->ts_entries[ts_set->ts_init_count++] = set_entry;
@@ -617,6 +632,14 @@ vos_ts_peek_entry(uint32_t *idx, uint32_t type, struct vos_ts_entry **entryp)
 int
 vos_ts_table_alloc(struct vos_ts_table **ts_table);
 
+/** Register timestamp cache telemetry and enable adaptive sizing of the
+ *  cache.  Only done for engine targets, standalone VOS keeps fixed sizes.
+ *
+ * \param[in]	ts_table	Thread local table
+ * \param[in]	tgt_id		Target index
+ */
+void
+vos_ts_table_metrics_init(struct vos_ts_table *ts_table, int tgt_id);
 
 /** Free the thread local timestamp cache and reset pointer to NULL
  *
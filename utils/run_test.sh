@@ -208,6 +208,7 @@ if [ -d "/mnt/daos" ]; then
     COMP="UTEST_vos"
     run_test src/vos/tests/evt_ctl.sh
     run_test src/vos/tests/evt_ctl.sh pmem
+    run_test src/vos/tests/evt_ctl.sh --sort=child_mbr
     unset USE_VALGRIND
     unset VALGRIND_SUPP
 